@@ -27,6 +27,11 @@ std::vector<std::string> FileSystem::EnumAllFiles(std::string_view mask)
 	return std::vector<std::string>();
 }
 
+bool FileSystem::GetFileInfo(std::string_view fileName, FileInfo &info)
+{
+	return false;
+}
+
 std::shared_ptr<FS::FileSystem> FileSystem::GetFileSystem(std::string_view path, bool create, bool nothrow)
 {
 	assert(!path.empty());
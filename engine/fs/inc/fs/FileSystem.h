@@ -29,6 +29,12 @@ struct Stream
 	virtual long long Tell() const = 0;
 };
 
+struct FileInfo
+{
+	unsigned long long size = 0;
+	long long modified = 0; // platform specific timestamp, only meaningful for comparison
+};
+
 struct File
 {
 	virtual std::shared_ptr<MemMap> QueryMap() = 0;
@@ -40,6 +46,8 @@ class FileSystem
 public:
 	virtual std::shared_ptr<FileSystem> GetFileSystem(std::string_view path, bool create = false, bool nothrow = false);
 	virtual std::vector<std::string> EnumAllFiles(std::string_view mask);
+	// returns false if the file does not exist or the file system can't tell
+	virtual bool GetFileInfo(std::string_view fileName, FileInfo &info);
 	std::shared_ptr<File> Open(std::string_view path, FileMode mode = ModeRead, bool nothrow = false);
 	void Mount(std::string_view nodeName, std::shared_ptr<FileSystem> fs);
 
@@ -188,6 +188,16 @@ static std::string PathCombine(std::string_view first, std::string_view second)
 	return result;
 }
 
+bool FS::FileSystemPosix::GetFileInfo(std::string_view fileName, FileInfo &info)
+{
+    struct stat sb;
+    if( stat(PathCombine(_rootDirectory, fileName).c_str(), &sb) || !S_ISREG(sb.st_mode) )
+        return false;
+    info.size = static_cast<unsigned long long>(sb.st_size);
+    info.modified = static_cast<long long>(sb.st_mtime);
+    return true;
+}
+
 std::shared_ptr<FS::File> FS::FileSystemPosix::RawOpen(std::string_view fileName, FileMode mode, bool nothrow)
 {
     auto fullPath = PathCombine(_rootDirectory, fileName);
@@ -79,6 +79,7 @@ public:
     FileSystemPosix(std::string rootDirectory);
 	std::shared_ptr<FileSystem> GetFileSystem(std::string_view path, bool create = false, bool nothrow = false) override;
 	std::vector<std::string> EnumAllFiles(std::string_view mask) override;
+	bool GetFileInfo(std::string_view fileName, FileInfo &info) override;
 };
 
 } // namespace FS
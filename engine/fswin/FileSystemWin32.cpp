@@ -389,6 +389,19 @@ std::vector<std::string> FileSystemWin32::EnumAllFiles(std::string_view mask)
 	return files;
 }
 
+bool FileSystemWin32::GetFileInfo(std::string_view fileName, FileInfo &info)
+{
+	WIN32_FILE_ATTRIBUTE_DATA fad;
+	if (!GetFileAttributesExW(WinPathCombine(_rootDirectory, fileName).c_str(), GetFileExInfoStandard, &fad) ||
+		(fad.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY))
+	{
+		return false;
+	}
+	info.size = (static_cast<unsigned long long>(fad.nFileSizeHigh) << 32) | fad.nFileSizeLow;
+	info.modified = static_cast<long long>((static_cast<unsigned long long>(fad.ftLastWriteTime.dwHighDateTime) << 32) | fad.ftLastWriteTime.dwLowDateTime);
+	return true;
+}
+
 std::shared_ptr<File> FileSystemWin32::RawOpen(std::string_view fileName, FileMode mode, bool nothrow)
 {
 	// combine with the root path
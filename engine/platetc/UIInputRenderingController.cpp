@@ -94,7 +94,8 @@ void UIInputRenderingController::OnRefresh(Plat::AppWindow& appWindow, IRender&
 
 	ImageCache imageCache;
 	rb.Update(RenderBindingEnv{ _fs, _textureManager, imageCache, render });
-	RenderContext rc(_textureManager, rb, render, displayWidth, displayHeight);
+	RenderCounting countingRender(render);
+	RenderContext rc(_textureManager, rb, countingRender, displayWidth, displayHeight, &_textLayoutCache);
 
 	UI::DataContext dataContext;
 	UI::LayoutContext layoutContext(1.f, appWindow.GetLayoutScale(), vec2d{}, pxWindowSize, true /* enabled */, _inputContext.GetMainWindowActive());
@@ -129,6 +130,11 @@ void UIInputRenderingController::OnRefresh(Plat::AppWindow& appWindow, IRender&
 		rs.rc.DrawSprite(dst, 0U, 0xffffffff, 0U);
 	}
 #endif
+
+	_renderStatistics = countingRender.GetStatistics();
+	_contextStatistics = rc.GetStatistics();
+	_textLayoutCache.EndFrame();
+	rb.ReleaseUnusedImages(render);
 }
 
 bool UIInputRenderingController::HandleClipboardShortcuts(Plat::AppWindow& appWindow, Plat::Key key, Plat::Msg action)
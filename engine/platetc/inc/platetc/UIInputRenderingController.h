@@ -2,6 +2,8 @@
 #include <plat/AppWindow.h>
 #include <ui/InputContext.h>
 #include <video/RenderBinding.h>
+#include <video/RenderContext.h>
+#include <video/RenderCounting.h>
 
 namespace UI
 {
@@ -21,6 +23,10 @@ public:
 
 	void TimeStep(float dt, const Plat::Input& input);
 
+	// counters of the last rendered frame
+	const RenderStatistics& GetRenderStatistics() const { return _renderStatistics; }
+	const RenderContext::Statistics& GetContextStatistics() const { return _contextStatistics; }
+
 	// AppWindowInputSink
 	bool OnChar(Plat::AppWindow& appWindow, unsigned int codepoint) override;
 	bool OnKey(Plat::AppWindow& appWindow, Plat::Key key, Plat::Msg action) override;
@@ -40,4 +46,7 @@ private:
 	TextureManager &_textureManager;
 	UI::TimeStepManager &_timeStepManager;
 	std::shared_ptr<UI::Window> _desktop;
+	RenderStatistics _renderStatistics;
+	RenderContext::Statistics _contextStatistics;
+	TextLayoutCache _textLayoutCache;
 };
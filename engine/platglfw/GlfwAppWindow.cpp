@@ -4,8 +4,14 @@
 #include <plat/Input.h>
 #include <video/RenderBinding.h>
 #include <video/RenderOpenGL.h>
+#include <video/RenderRecorder.h>
+#include <video/TripleBuffer.h>
 #include <GLFW/glfw3.h>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
 #include <stdexcept>
+#include <thread>
 
 static Plat::AppWindowInputSink* s_inputSink;
 
@@ -163,7 +169,8 @@ static void OnKey(GLFWwindow *window, int platformKey, int scancode, int platfor
 				glfwGetWindowPos(window, &self->_windowedLeft, &self->_windowedTop);
 				glfwSetWindowMonitor(window, monitor, 0, 0,
 					glfwGetVideoMode(monitor)->width, glfwGetVideoMode(monitor)->height, GLFW_DONT_CARE);
-				glfwSwapInterval(1);
+				if (glfwGetCurrentContext()) // otherwise the context belongs to the render thread
+					glfwSwapInterval(1);
 			}
 			else
 			{
@@ -221,7 +228,23 @@ static std::unique_ptr<GLFWwindow, GlfwWindowDeleter> NewWindow(const char *titl
 	return result;
 }
 
-GlfwAppWindow::GlfwAppWindow(const char *title, bool fullscreen, int width, int height)
+struct GlfwAppWindow::RenderThread
+{
+	RenderRecorder recorder;
+	RenderPlayer player{ recorder };
+	TripleBuffer<RecordedFrame> frames;
+
+	std::mutex mutex;
+	std::condition_variable cv;
+	bool framePending = false;
+	bool stop = false;
+	std::thread thread;
+};
+
+// how long Present waits for the render thread to pick up the previous frame
+static constexpr std::chrono::milliseconds MAX_PRESENT_WAIT(33);
+
+GlfwAppWindow::GlfwAppWindow(const char *title, bool fullscreen, int width, int height, bool renderThread)
 	: _window(NewWindow(title, fullscreen, width, height))
 	, _cursorArrow(glfwCreateStandardCursor(GLFW_ARROW_CURSOR))
 	, _cursorIBeam(glfwCreateStandardCursor(GLFW_IBEAM_CURSOR))
@@ -242,14 +265,37 @@ GlfwAppWindow::GlfwAppWindow(const char *title, bool fullscreen, int width, int
 	glfwSwapInterval(1);
 
 	glfwSetWindowUserPointer(_window.get(), this);
+
+	if (renderThread)
+	{
+		glfwMakeContextCurrent(nullptr);
+		_renderThread.reset(new RenderThread());
+		_renderThread->thread = std::thread([this] { RenderLoop(); });
+	}
 }
 
 GlfwAppWindow::~GlfwAppWindow()
 {
 	glfwSetWindowUserPointer(_window.get(), nullptr);
 
-	glfwMakeContextCurrent(_window.get());
-	_renderBinding->UnloadAllTextures(*_render);
+	if (_renderThread)
+	{
+		_renderBinding->UnloadAllTextures(_renderThread->recorder);
+		{
+			std::lock_guard<std::mutex> lock(_renderThread->mutex);
+			_renderThread->stop = true;
+		}
+		_renderThread->cv.notify_all();
+		_renderThread->thread.join();
+		_renderThread.reset();
+
+		glfwMakeContextCurrent(_window.get());
+	}
+	else
+	{
+		glfwMakeContextCurrent(_window.get());
+		_renderBinding->UnloadAllTextures(*_render);
+	}
 	_renderBinding.reset();
 	_render.reset();
 	glfwMakeContextCurrent(nullptr);
@@ -267,11 +313,17 @@ GlfwInput& GlfwAppWindow::GetInput()
 
 IRender& GlfwAppWindow::GetRender()
 {
-	glfwMakeContextCurrent(_window.get());
-
 	int width;
 	int height;
 	glfwGetFramebufferSize(_window.get(), &width, &height);
+
+	if (_renderThread)
+	{
+		_renderThread->recorder.Begin(_renderThread->frames.GetBack(), width, height, DO_0);
+		return _renderThread->recorder;
+	}
+
+	glfwMakeContextCurrent(_window.get());
 	_render->Begin(width, height, DO_0);
 	return *_render;
 }
@@ -311,12 +363,59 @@ void GlfwAppWindow::SetMouseCursor(Plat::MouseCursor mouseCursor)
 
 void GlfwAppWindow::Present()
 {
+	if (_renderThread)
+	{
+		RenderThread &rt = *_renderThread;
+		rt.recorder.End();
+		rt.frames.Publish();
+
+		std::unique_lock<std::mutex> lock(rt.mutex);
+		rt.framePending = true;
+		rt.cv.notify_all();
+		// keep within a frame of the display without waiting out a stalled driver
+		rt.cv.wait_for(lock, MAX_PRESENT_WAIT, [&rt] { return !rt.framePending; });
+		return;
+	}
+
 	assert(glfwGetCurrentContext() == _window.get());
 	_render->End();
 	glfwSwapBuffers(_window.get());
 	glFinish(); // prevent gpu queue growth to reduce input lag, only seems to help in full screen
 }
 
+void GlfwAppWindow::RenderLoop()
+{
+	RenderThread &rt = *_renderThread;
+	glfwMakeContextCurrent(_window.get());
+	glfwSwapInterval(1);
+
+	for (;;)
+	{
+		{
+			std::unique_lock<std::mutex> lock(rt.mutex);
+			rt.cv.wait(lock, [&rt] { return rt.framePending || rt.stop; });
+			if (rt.stop)
+				break;
+			rt.framePending = false;
+		}
+		rt.cv.notify_all();
+
+		// the frame on screen is already the latest one
+		if (!rt.frames.Acquire())
+			continue;
+
+		const RecordedFrame &frame = rt.frames.GetFront();
+		_render->Begin(frame.GetWidth(), frame.GetHeight(), DO_0);
+		rt.player.Play(frame, *_render);
+		_render->End();
+		glfwSwapBuffers(_window.get());
+		glFinish();
+	}
+
+	rt.player.ReleaseTextures(*_render);
+	glfwMakeContextCurrent(nullptr);
+}
+
 bool GlfwAppWindow::ShouldClose() const
 {
 	return !!glfwWindowShouldClose(_window.get());
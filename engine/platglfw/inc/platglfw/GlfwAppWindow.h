@@ -36,7 +36,9 @@ class GlfwAppWindow final
 	, private Plat::AppWindowCommandClose
 {
 public:
-	GlfwAppWindow(const char *title, bool fullscreen, int width, int height);
+	// with renderThread the frames are recorded by the caller and played on a separate thread,
+	// so a stalled driver does not hold up the caller's loop
+	GlfwAppWindow(const char *title, bool fullscreen, int width, int height, bool renderThread = false);
 	~GlfwAppWindow();
 
 	static void PollEvents(Plat::AppWindowInputSink& inputSink);
@@ -64,6 +66,8 @@ public:
 	void RequestClose() override;
 
 private:
+	struct RenderThread;
+
 	GlfwInitHelper _initHelper;
 	std::unique_ptr<GLFWwindow, GlfwWindowDeleter> _window;
 	std::unique_ptr<GLFWcursor, GlfwCursorDeleter> _cursorArrow;
@@ -72,4 +76,7 @@ private:
 	std::unique_ptr<GlfwInput> _input;
 	std::unique_ptr<RenderOpenGL> _render;
 	std::unique_ptr<RenderBinding> _renderBinding;
+	std::unique_ptr<RenderThread> _renderThread;
+
+	void RenderLoop();
 };
@@ -7,6 +7,7 @@
 RenderBinding::~RenderBinding()
 {
 	assert(_devTextures.empty());
+	assert(_images.empty());
 }
 
 void RenderBinding::Update(const RenderBindingEnv& env)
@@ -49,6 +50,41 @@ void RenderBinding::UnloadAllTextures(IRender& render) noexcept
 		render.TexFree(t.id);
 	_devTextures.clear();
 	_sprites.clear();
+
+	for (auto& keyAndTexture : _images)
+		render.TexFree(keyAndTexture.second.id);
+	_images.clear();
+}
+
+DEV_TEXTURE RenderBinding::GetImageTexture(IRender& render, const std::shared_ptr<const Image>& image)
+{
+	auto it = _images.find(image.get());
+	if (_images.end() == it)
+	{
+		ImageTexture texture = { image, {}, false };
+		if (!render.TexCreate(texture.id, image->GetData(), true /* magFilter */))
+			throw std::runtime_error("error in render device");
+		it = _images.emplace(image.get(), std::move(texture)).first;
+	}
+	it->second.used = true;
+	return it->second.id;
+}
+
+void RenderBinding::ReleaseUnusedImages(IRender& render) noexcept
+{
+	for (auto it = _images.begin(); it != _images.end(); )
+	{
+		if (it->second.used)
+		{
+			it->second.used = false;
+			++it;
+		}
+		else
+		{
+			render.TexFree(it->second.id);
+			it = _images.erase(it);
+		}
+	}
 }
 
 RenderBinding::SpriteRef& RenderBinding::EnsureSpriteRef(size_t spriteId)
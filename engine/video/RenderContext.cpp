@@ -3,10 +3,12 @@
 #include "inc/video/TextureManager.h"
 #include <algorithm>
 
-RenderContext::RenderContext(const TextureManager &tm, const RenderBinding& rb, IRender &render, unsigned int width, unsigned int height)
+RenderContext::RenderContext(const TextureManager &tm, RenderBinding& rb, IRender &render, unsigned int width, unsigned int height,
+                             TextLayoutCache *textLayoutCache)
 	: _tm(tm)
 	, _rb(rb)
 	, _render(render)
+	, _textLayoutCache(textLayoutCache)
 	, _currentTransform{ vec2d{}, 1, 0xff }
 	, _mode(RM_UNDEFINED)
 {
@@ -26,14 +28,16 @@ void RenderContext::PushClippingRect(RectRB rect)
 	RectRB newClip = RectClamp(_clipStack.top(), rect);
 	assert(newClip.right >= newClip.left && newClip.bottom >= newClip.top);
 
+	_statistics.clipPushes++;
+
 	_clipStack.push(newClip);
-	_render.SetScissor(newClip);
+	SetScissor(newClip);
 }
 
 void RenderContext::PopClippingRect()
 {
 	_clipStack.pop();
-	_render.SetScissor(_clipStack.top());
+	SetScissor(_clipStack.top());
 }
 
 void RenderContext::PushTransform(vec2d offset, float opacityCombined)
@@ -49,7 +53,7 @@ void RenderContext::PushWorldTransform(vec2d offset, float scale, float opacity)
 	auto opacityCombined = (_currentTransform.opacity * (opacity8bit + 1)) >> 8;
 	_transformStack.push({ _currentTransform.offset + offset, _currentTransform.scale * scale, opacityCombined, true /*hardware*/ });
 	_currentTransform = _transformStack.top();
-	_render.SetTransform(_currentTransform.offset, _currentTransform.scale);
+	SetTransform(_currentTransform.offset, _currentTransform.scale);
 }
 
 void RenderContext::PopTransform()
@@ -60,11 +64,11 @@ void RenderContext::PopTransform()
 	_currentTransform = _transformStack.top();
 	if (_currentTransform.hardware)
 	{
-		_render.SetTransform(_currentTransform.offset, _currentTransform.scale);
+		SetTransform(_currentTransform.offset, _currentTransform.scale);
 	}
 	else if (wasHardware)
 	{
-		_render.SetTransform({}, 1);
+		SetTransform({}, 1);
 	}
 }
 
@@ -88,8 +92,26 @@ void RenderContext::DrawSprite(FRECT dst, size_t sprite, SpriteColor color, unsi
 	if (color.a == 0)
 		return;
 
-	FRECT rt = _rb.GetUVFrames(sprite)[frame];
-	MyVertex *v = _render.DrawQuad(_rb.GetDeviceTexture(sprite));
+	_statistics.sprites++;
+
+	DrawTexturedRect(_rb.GetDeviceTexture(sprite), dst, _rb.GetUVFrames(sprite)[frame], color);
+}
+
+void RenderContext::DrawImage(FRECT dst, const std::shared_ptr<const Image> &image, SpriteColor color)
+{
+	color = ApplyOpacity(color, _currentTransform.opacity);
+
+	if (color.a == 0)
+		return;
+
+	_statistics.sprites++;
+
+	DrawTexturedRect(_rb.GetImageTexture(_render, image), dst, FRECT{ 0, 0, 1, 1 }, color);
+}
+
+void RenderContext::DrawTexturedRect(DEV_TEXTURE tex, FRECT dst, FRECT rt, SpriteColor color)
+{
+	MyVertex *v = DrawQuad(tex);
 
 	if (!_currentTransform.hardware)
 	{
@@ -144,10 +166,9 @@ void RenderContext::DrawBorder(FRECT dst, size_t sprite, SpriteColor color, unsi
 	}
 
 	MyVertex *v;
-	IRender &render = _render;
 
 	// left edge
-	v = render.DrawQuad(devtex);
+	v = DrawQuad(devtex);
 	v[0].color = color;
 	v[0].u = uvFrame.left - uvBorderWidth;
 	v[0].v = uvFrame.top;
@@ -170,7 +191,7 @@ void RenderContext::DrawBorder(FRECT dst, size_t sprite, SpriteColor color, unsi
 	v[3].y = dst.bottom - lt.pxBorderSize;
 
 	// right edge
-	v = render.DrawQuad(devtex);
+	v = DrawQuad(devtex);
 	v[0].color = color;
 	v[0].u = uvFrame.right;
 	v[0].v = uvFrame.top;
@@ -193,7 +214,7 @@ void RenderContext::DrawBorder(FRECT dst, size_t sprite, SpriteColor color, unsi
 	v[3].y = dst.bottom - lt.pxBorderSize;
 
 	// top edge
-	v = render.DrawQuad(devtex);
+	v = DrawQuad(devtex);
 	v[0].color = color;
 	v[0].u = uvFrame.left;
 	v[0].v = uvFrame.top - uvBorderHeight;
@@ -216,7 +237,7 @@ void RenderContext::DrawBorder(FRECT dst, size_t sprite, SpriteColor color, unsi
 	v[3].y = dst.top + lt.pxBorderSize;
 
 	// bottom edge
-	v = render.DrawQuad(devtex);
+	v = DrawQuad(devtex);
 	v[0].color = color;
 	v[0].u = uvFrame.left;
 	v[0].v = uvFrame.bottom;
@@ -239,7 +260,7 @@ void RenderContext::DrawBorder(FRECT dst, size_t sprite, SpriteColor color, unsi
 	v[3].y = dst.bottom;
 
 	// left top corner
-	v = render.DrawQuad(devtex);
+	v = DrawQuad(devtex);
 	v[0].color = color;
 	v[0].u = uvFrame.left - uvBorderWidth;
 	v[0].v = uvFrame.top - uvBorderHeight;
@@ -262,7 +283,7 @@ void RenderContext::DrawBorder(FRECT dst, size_t sprite, SpriteColor color, unsi
 	v[3].y = dst.top + lt.pxBorderSize;
 
 	// right top corner
-	v = render.DrawQuad(devtex);
+	v = DrawQuad(devtex);
 	v[0].color = color;
 	v[0].u = uvFrame.right;
 	v[0].v = uvFrame.top - uvBorderHeight;
@@ -285,7 +306,7 @@ void RenderContext::DrawBorder(FRECT dst, size_t sprite, SpriteColor color, unsi
 	v[3].y = dst.top + lt.pxBorderSize;
 
 	// right bottom corner
-	v = render.DrawQuad(devtex);
+	v = DrawQuad(devtex);
 	v[0].color = color;
 	v[0].u = uvFrame.right;
 	v[0].v = uvFrame.bottom;
@@ -308,7 +329,7 @@ void RenderContext::DrawBorder(FRECT dst, size_t sprite, SpriteColor color, unsi
 	v[3].y = dst.bottom;
 
 	// left bottom corner
-	v = render.DrawQuad(devtex);
+	v = DrawQuad(devtex);
 	v[0].color = color;
 	v[0].u = uvFrame.left - uvBorderWidth;
 	v[0].v = uvFrame.bottom;
@@ -347,38 +368,14 @@ void RenderContext::DrawBitmapText(FRECT rect, float scale, size_t tex, SpriteCo
 	static const float dx[] = { 0, 1, 2, 0, 1, 2, 0, 1, 2 };
 	static const float dy[] = { 0, 0, 0, 1, 1, 1, 2, 2, 2 };
 
-	int lineCount = 0;
-	size_t maxline = 0;
-	if( align )
-	{
-		size_t count = 0;
-		for(auto tmp = str.cbegin(); tmp != str.cend(); )
-		{
-			++count;
-			++tmp;
-			if( str.cend() == tmp || '\n' == *tmp )
-			{
-				if( maxline < count )
-					maxline = count;
-				lineCount++;
-				count = 0;
-			}
-		}
-	}
-
-	LogicalTexture lt = _tm.GetSpriteInfo(tex);
-	IRender &render = _render;
+	const TextLayoutCache::Layout *layout = &_textLayout;
+	if (_textLayoutCache)
+		layout = &_textLayoutCache->GetLayout(_tm, tex, scale, str);
+	else
+		TextLayoutCache::BuildLayout(_tm, tex, scale, str, _textLayout);
 
-	int count = 0;
-	int line  = 0;
-
-	vec2d pxCharSize = Vec2dFloor(vec2d{ lt.pxFrameWidth, lt.pxFrameHeight } * scale);
-	float pxAdvance = std::floor((lt.pxFrameWidth - 1) * scale);
-
-	vec2d pxTextSize = { pxAdvance * (float)maxline, pxCharSize.y * (float)lineCount };
-
-	float x0 = rect.left + std::floor(dx[align] * (WIDTH(rect) - pxTextSize.x) / 2);
-	float y0 = rect.top + std::floor(dy[align] * (HEIGHT(rect) - pxTextSize.y) / 2);
+	float x0 = rect.left + std::floor(dx[align] * (WIDTH(rect) - layout->pxTextSize.x) / 2);
+	float y0 = rect.top + std::floor(dy[align] * (HEIGHT(rect) - layout->pxTextSize.y) / 2);
 
 	if (!_currentTransform.hardware)
 	{
@@ -386,25 +383,18 @@ void RenderContext::DrawBitmapText(FRECT rect, float scale, size_t tex, SpriteCo
 		y0 += _currentTransform.offset.y;
 	}
 
-	for(auto tmp = str.cbegin(); tmp != str.cend(); ++tmp )
-	{
-		if( '\n' == *tmp )
-		{
-			++line;
-			count = 0;
-		}
-
-		int frame = (int)(unsigned char)*tmp - lt.leadChar;
-		if( frame < 0 || frame >= lt.frameCount )
-		{
-			continue;
-		}
+	const FRECT *uvFrames = _rb.GetUVFrames(tex);
+	DEV_TEXTURE devTexture = _rb.GetDeviceTexture(tex);
+	vec2d pxCharSize = layout->pxCharSize;
 
-		const FRECT &rt = _rb.GetUVFrames(tex)[frame];
-		float x = x0 + (float) ((count++) * pxAdvance);
-		float y = y0 + (float) (line * pxCharSize.y);
+	for (const TextLayoutCache::Glyph &glyph: layout->glyphs)
+	{
+		const FRECT &rt = uvFrames[glyph.frame];
+		float x = x0 + glyph.offset.x;
+		float y = y0 + glyph.offset.y;
+		_statistics.glyphs++;
 
-		MyVertex *v = render.DrawQuad(_rb.GetDeviceTexture(tex));
+		MyVertex *v = DrawQuad(devTexture);
 
 		v[0].color = color;
 		v[0].u = rt.left;
@@ -439,11 +429,13 @@ void RenderContext::DrawSprite(size_t tex, unsigned int frame, SpriteColor color
 	if (color.a == 0)
 		return;
 
+	_statistics.sprites++;
+
 	assert(frame < _tm.GetFrameCount(tex));
 	const LogicalTexture &lt = _tm.GetSpriteInfo(tex);
 	FRECT rt = _rb.GetUVFrames(tex)[frame];
 
-	MyVertex *v = _render.DrawQuad(_rb.GetDeviceTexture(tex));
+	MyVertex *v = DrawQuad(_rb.GetDeviceTexture(tex));
 
 	if (!_currentTransform.hardware)
 	{
@@ -488,10 +480,12 @@ void RenderContext::DrawSprite(size_t tex, unsigned int frame, SpriteColor color
 	if (color.a == 0)
 		return;
 
+	_statistics.sprites++;
+
 	const LogicalTexture &lt = _tm.GetSpriteInfo(tex);
 	const FRECT &rt = _rb.GetUVFrames(tex)[frame];
 
-	MyVertex *v = _render.DrawQuad(_rb.GetDeviceTexture(tex));
+	MyVertex *v = DrawQuad(_rb.GetDeviceTexture(tex));
 
 	if (!_currentTransform.hardware)
 	{
@@ -536,7 +530,7 @@ void RenderContext::DrawIndicator(size_t tex, vec2d pos, float value)
 	float px = lt.pxPivot.x;
 	float py = lt.pxPivot.y;
 
-	MyVertex *v = _render.DrawQuad(_rb.GetDeviceTexture(tex));
+	MyVertex *v = DrawQuad(_rb.GetDeviceTexture(tex));
 
 	v[0].color = color;
 	v[0].u = rt.left;
@@ -572,9 +566,8 @@ void RenderContext::DrawLine(size_t tex, SpriteColor color, vec2d begin, vec2d e
 
 	const LogicalTexture &lt = _tm.GetSpriteInfo(tex);
 	FRECT rt = _rb.GetUVFrames(tex)[0];
-	IRender &render = _render;
 
-	MyVertex *v = render.DrawQuad(_rb.GetDeviceTexture(tex));
+	MyVertex *v = DrawQuad(_rb.GetDeviceTexture(tex));
 
 	float len = (begin - end).len();
 	float uvStart = phase / lt.pxFrameWidth;
@@ -608,13 +601,12 @@ void RenderContext::DrawLine(size_t tex, SpriteColor color, vec2d begin, vec2d e
 	v[3].y = begin.y + py * c;
 }
 
-void RenderContext::DrawBackground(size_t tex, FRECT bounds) const
+void RenderContext::DrawBackground(size_t tex, FRECT bounds)
 {
 	SpriteColor color = ApplyOpacity(0xffffffff, _currentTransform.opacity);
 
 	const LogicalTexture &lt = _tm.GetSpriteInfo(tex);
-	IRender &render = _render;
-	MyVertex *v = render.DrawQuad(_rb.GetDeviceTexture(tex));
+	MyVertex *v = DrawQuad(_rb.GetDeviceTexture(tex));
 	v[0].color = color;
 	v[0].u = bounds.left / lt.pxFrameWidth;
 	v[0].v = bounds.top / lt.pxFrameHeight;
@@ -653,12 +645,13 @@ static float sintable[SINTABLE_SIZE] = {
 
 void RenderContext::DrawPointLight(float intensity, float radius, vec2d pos)
 {
+	_statistics.lights++;
+
 	SpriteColor color;
 	color.color = 0x00000000;
 	color.a = (unsigned char) std::max(0, std::min(255, int(255.0f * intensity)));
 
-	IRender &render = _render;
-	MyVertex *v = render.DrawFan(SINTABLE_SIZE>>1);
+	MyVertex *v = DrawFan(SINTABLE_SIZE>>1);
 	v[0].color = color;
 	v[0].x = pos.x;
 	v[0].y = pos.y;
@@ -672,12 +665,13 @@ void RenderContext::DrawPointLight(float intensity, float radius, vec2d pos)
 
 void RenderContext::DrawSpotLight(float intensity, float radius, vec2d pos, vec2d dir, float offset, float aspect)
 {
+	_statistics.lights++;
+
 	SpriteColor color;
 	color.color = 0x00000000;
 	color.a = (unsigned char) std::max(0, std::min(255, int(255.0f * intensity)));
 
-	IRender &render = _render;
-	MyVertex *v = render.DrawFan(SINTABLE_SIZE);
+	MyVertex *v = DrawFan(SINTABLE_SIZE);
 	v[0].color = color;
 	v[0].x = pos.x;
 	v[0].y = pos.y;
@@ -693,12 +687,13 @@ void RenderContext::DrawSpotLight(float intensity, float radius, vec2d pos, vec2
 
 void RenderContext::DrawDirectLight(float intensity, float radius, vec2d pos, vec2d dir, float length)
 {
+	_statistics.lights++;
+
 	SpriteColor color;
 	color.color = 0x00000000;
 	color.a = (unsigned char) std::max(0, std::min(255, int(255.0f * intensity)));
 
-	IRender &render = _render;
-	MyVertex *v = render.DrawFan((SINTABLE_SIZE>>2)+4);
+	MyVertex *v = DrawFan((SINTABLE_SIZE>>2)+4);
 	v[0].color = color;
 	v[0].x = pos.x;
 	v[0].y = pos.y;
@@ -723,7 +718,7 @@ void RenderContext::DrawDirectLight(float intensity, float radius, vec2d pos, ve
 	v[(SINTABLE_SIZE>>2)+4].x = pos.x + length * dir.x - radius*dir.y;
 	v[(SINTABLE_SIZE>>2)+4].y = pos.y + length * dir.y + radius*dir.x;
 
-	v = render.DrawFan((SINTABLE_SIZE>>2)+1);
+	v = DrawFan((SINTABLE_SIZE>>2)+1);
 	v[0].color = color;
 	v[0].x = pos.x + length * dir.x;
 	v[0].y = pos.y + length * dir.y;
@@ -744,9 +739,101 @@ void RenderContext::SetAmbient(float ambient)
 
 void RenderContext::SetMode(RenderMode mode)
 {
+	assert(!_drawListOpen);
 	if (_mode != mode)
 	{
 		_render.SetMode(mode);
 		_mode = mode;
 	}
 }
+
+void RenderContext::BeginDrawList()
+{
+	assert(!_drawListOpen);
+	_drawListOpen = true;
+	_drawLayer = 0;
+	if (_currentTransform.hardware)
+		_drawStates.push_back({ _clipStack.top(), _currentTransform.offset, _currentTransform.scale });
+	else
+		_drawStates.push_back({ _clipStack.top(), vec2d{}, 1 });
+}
+
+void RenderContext::SetDrawLayer(unsigned int layer)
+{
+	assert(_drawListOpen);
+	_drawLayer = layer;
+}
+
+void RenderContext::EndDrawList()
+{
+	assert(_drawListOpen);
+	_drawListOpen = false;
+
+	std::stable_sort(_drawList.begin(), _drawList.end(), [](const DeferredQuad &a, const DeferredQuad &b)
+	{
+		if (a.layer != b.layer)
+			return a.layer < b.layer;
+		if (a.state != b.state)
+			return a.state < b.state;
+		return a.texture < b.texture;
+	});
+
+	unsigned int state = 0;
+	for (const DeferredQuad &quad: _drawList)
+	{
+		if (quad.state != state)
+		{
+			state = quad.state;
+			SetScissor(_drawStates[state].clip);
+			SetTransform(_drawStates[state].offset, _drawStates[state].scale);
+		}
+		std::copy(std::begin(quad.v), std::end(quad.v), DrawQuad(quad.texture));
+	}
+
+	if (state + 1 != _drawStates.size())
+	{
+		// the state at the end of the list
+		SetScissor(_drawStates.back().clip);
+		SetTransform(_drawStates.back().offset, _drawStates.back().scale);
+	}
+
+	_drawList.clear();
+	_drawStates.clear();
+}
+
+MyVertex* RenderContext::DrawQuad(DEV_TEXTURE tex)
+{
+	if (_drawListOpen)
+	{
+		_drawList.push_back({ _drawLayer, (unsigned int)_drawStates.size() - 1, tex });
+		return _drawList.back().v;
+	}
+
+	return _render.DrawQuad(tex);
+}
+
+MyVertex* RenderContext::DrawFan(unsigned int nEdges)
+{
+	assert(!_drawListOpen);
+	return _render.DrawFan(nEdges);
+}
+
+void RenderContext::SetScissor(const RectRB &rect)
+{
+	if (_drawListOpen)
+	{
+		_drawStates.push_back({ rect, _drawStates.back().offset, _drawStates.back().scale });
+		return;
+	}
+	_render.SetScissor(rect);
+}
+
+void RenderContext::SetTransform(vec2d offset, float scale)
+{
+	if (_drawListOpen)
+	{
+		_drawStates.push_back({ _drawStates.back().clip, offset, scale });
+		return;
+	}
+	_render.SetTransform(offset, scale);
+}
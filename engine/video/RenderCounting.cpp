@@ -0,0 +1,93 @@
+#include "inc/video/RenderCounting.h"
+
+RenderCounting::RenderCounting(IRender &render)
+	: _render(render)
+{
+}
+
+RenderStatistics RenderCounting::GetStatistics() const
+{
+	RenderStatistics result = _statistics;
+	if (_batchOpen)
+		result.flushes++;
+	return result;
+}
+
+void RenderCounting::ResetStatistics()
+{
+	_statistics = RenderStatistics();
+	_batchOpen = false;
+}
+
+void RenderCounting::SetScissor(const RectRB &rect)
+{
+	EndBatch();
+	_render.SetScissor(rect);
+}
+
+void RenderCounting::SetViewport(const RectRB &rect)
+{
+	EndBatch();
+	_render.SetViewport(rect);
+}
+
+void RenderCounting::SetTransform(vec2d offset, float scale)
+{
+	EndBatch();
+	_render.SetTransform(offset, scale);
+}
+
+void RenderCounting::SetMode(const RenderMode mode)
+{
+	EndBatch();
+	_render.SetMode(mode);
+}
+
+void RenderCounting::SetAmbient(float ambient)
+{
+	_render.SetAmbient(ambient);
+}
+
+bool RenderCounting::TexCreate(DEV_TEXTURE &tex, ImageView img, bool magFilter)
+{
+	return _render.TexCreate(tex, img, magFilter);
+}
+
+void RenderCounting::TexFree(DEV_TEXTURE tex)
+{
+	if (_textureBound && _boundTexture == tex)
+		_textureBound = false;
+	_render.TexFree(tex);
+}
+
+MyVertex* RenderCounting::DrawQuad(DEV_TEXTURE tex)
+{
+	if (!_textureBound || !(_boundTexture == tex))
+	{
+		EndBatch();
+		_statistics.textureBinds++;
+		_textureBound = true;
+		_boundTexture = tex;
+	}
+	_batchOpen = true;
+	_statistics.quads++;
+	_statistics.vertices += 4;
+	return _render.DrawQuad(tex);
+}
+
+MyVertex* RenderCounting::DrawFan(unsigned int nEdges)
+{
+	_batchOpen = true;
+	_statistics.fans++;
+	_statistics.vertices += nEdges + 1;
+	return _render.DrawFan(nEdges);
+}
+
+void RenderCounting::EndBatch()
+{
+	if (_batchOpen)
+	{
+		_statistics.flushes++;
+		_batchOpen = false;
+	}
+}
@@ -0,0 +1,219 @@
+#include "inc/video/RenderRecorder.h"
+#include <algorithm>
+#include <cassert>
+#include <climits>
+#include <cstring>
+
+void RenderRecorder::Begin(RecordedFrame &frame, unsigned int displayWidth, unsigned int displayHeight, DisplayOrientation displayOrientation)
+{
+	assert(!_frame);
+	_frame = &frame;
+	_frame->_sequence = ++_sequence;
+	_frame->_width = displayWidth;
+	_frame->_height = displayHeight;
+	_frame->_orientation = displayOrientation;
+	_frame->_commands.clear();
+	_frame->_vertices.clear();
+}
+
+void RenderRecorder::End()
+{
+	assert(_frame);
+	_frame = nullptr;
+}
+
+RecordedFrame::Command& RenderRecorder::AddCommand(RecordedFrame::CommandType type)
+{
+	assert(_frame);
+	_frame->_commands.emplace_back();
+	RecordedFrame::Command &command = _frame->_commands.back();
+	command.type = type;
+	return command;
+}
+
+void RenderRecorder::SetScissor(const RectRB &rect)
+{
+	AddCommand(RecordedFrame::CommandType::Scissor).rect = rect;
+}
+
+void RenderRecorder::SetViewport(const RectRB &rect)
+{
+	AddCommand(RecordedFrame::CommandType::Viewport).rect = rect;
+}
+
+void RenderRecorder::SetTransform(vec2d offset, float scale)
+{
+	RecordedFrame::Command &command = AddCommand(RecordedFrame::CommandType::Transform);
+	command.offset = offset;
+	command.value = scale;
+}
+
+void RenderRecorder::SetMode(const RenderMode mode)
+{
+	AddCommand(RecordedFrame::CommandType::Mode).mode = mode;
+}
+
+void RenderRecorder::SetAmbient(float ambient)
+{
+	AddCommand(RecordedFrame::CommandType::Ambient).value = ambient;
+}
+
+bool RenderRecorder::TexCreate(DEV_TEXTURE &tex, ImageView img, bool magFilter)
+{
+	TextureOperation operation;
+	operation.handle = ++_lastHandle;
+	operation.sequence = _sequence;
+	operation.create = true;
+	operation.magFilter = magFilter;
+	operation.width = img.width;
+	operation.height = img.height;
+	operation.bpp = img.bpp;
+
+	size_t rowSize = img.width * img.bpp / 8;
+	operation.pixels.resize(rowSize * img.height);
+	for (int y = 0; y < img.height; y++)
+	{
+		memcpy(operation.pixels.data() + rowSize * y, static_cast<const uint8_t*>(img.pixels) + img.stride * y, rowSize);
+	}
+
+	tex.ptr = nullptr;
+	tex.index = operation.handle;
+
+	std::lock_guard<std::mutex> lock(_textureMutex);
+	_textureOperations.push_back(std::move(operation));
+	return true;
+}
+
+void RenderRecorder::TexFree(DEV_TEXTURE tex)
+{
+	TextureOperation operation = {};
+	operation.handle = tex.index;
+	operation.sequence = _sequence;
+	operation.create = false;
+
+	std::lock_guard<std::mutex> lock(_textureMutex);
+	_textureOperations.push_back(std::move(operation));
+}
+
+MyVertex* RenderRecorder::DrawQuad(DEV_TEXTURE tex)
+{
+	assert(_frame);
+	auto &commands = _frame->_commands;
+	if (commands.empty() || commands.back().type != RecordedFrame::CommandType::Quads || !(commands.back().texture == tex))
+	{
+		RecordedFrame::Command &command = AddCommand(RecordedFrame::CommandType::Quads);
+		command.texture = tex;
+		command.count = 0;
+	}
+	commands.back().count++;
+
+	auto &vertices = _frame->_vertices;
+	vertices.resize(vertices.size() + 4);
+	return &vertices[vertices.size() - 4];
+}
+
+MyVertex* RenderRecorder::DrawFan(unsigned int nEdges)
+{
+	AddCommand(RecordedFrame::CommandType::Fan).count = nEdges;
+
+	auto &vertices = _frame->_vertices;
+	vertices.resize(vertices.size() + nEdges + 1);
+	return &vertices[vertices.size() - nEdges - 1];
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+RenderPlayer::RenderPlayer(RenderRecorder &recorder)
+	: _recorder(recorder)
+{
+}
+
+void RenderPlayer::Play(const RecordedFrame &frame, IRender &render)
+{
+	UpdateTextures(render, frame._sequence);
+
+	const MyVertex *vertex = frame._vertices.data();
+	for (const RecordedFrame::Command &command: frame._commands)
+	{
+		switch (command.type)
+		{
+		case RecordedFrame::CommandType::Scissor:
+			render.SetScissor(command.rect);
+			break;
+		case RecordedFrame::CommandType::Viewport:
+			render.SetViewport(command.rect);
+			break;
+		case RecordedFrame::CommandType::Transform:
+			render.SetTransform(command.offset, command.value);
+			break;
+		case RecordedFrame::CommandType::Ambient:
+			render.SetAmbient(command.value);
+			break;
+		case RecordedFrame::CommandType::Mode:
+			render.SetMode(command.mode);
+			break;
+		case RecordedFrame::CommandType::Quads:
+			if (auto it = _textures.find(command.texture.index); it != _textures.end())
+			{
+				for (unsigned int i = 0; i < command.count; i++)
+					memcpy(render.DrawQuad(it->second), vertex + i * 4, sizeof(MyVertex) * 4);
+			}
+			vertex += command.count * 4;
+			break;
+		case RecordedFrame::CommandType::Fan:
+			memcpy(render.DrawFan(command.count), vertex, sizeof(MyVertex) * (command.count + 1));
+			vertex += command.count + 1;
+			break;
+		default:
+			assert(false);
+		}
+	}
+}
+
+void RenderPlayer::ReleaseTextures(IRender &render)
+{
+	UpdateTextures(render, UINT_MAX);
+	for (auto &handleAndTexture: _textures)
+		render.TexFree(handleAndTexture.second);
+	_textures.clear();
+}
+
+void RenderPlayer::UpdateTextures(IRender &render, unsigned int sequence)
+{
+	std::vector<RenderRecorder::TextureOperation> operations;
+	{
+		std::lock_guard<std::mutex> lock(_recorder._textureMutex);
+		operations.swap(_recorder._textureOperations);
+	}
+
+	// textures are created right away since frames that use them may have been skipped
+	for (auto &operation: operations)
+	{
+		if (operation.create)
+		{
+			ImageView img = { operation.pixels.data(), operation.width, operation.height, (int)(operation.width * operation.bpp / 8), operation.bpp };
+			DEV_TEXTURE tex;
+			if (render.TexCreate(tex, img, operation.magFilter))
+				_textures.emplace(operation.handle, tex);
+		}
+		else
+		{
+			_pendingFree.push_back(std::move(operation));
+		}
+	}
+
+	// but freed only after the last frame recorded before the request has been played
+	auto released = std::stable_partition(_pendingFree.begin(), _pendingFree.end(), [sequence](const RenderRecorder::TextureOperation &operation)
+	{
+		return operation.sequence >= sequence;
+	});
+	for (auto it = released; it != _pendingFree.end(); ++it)
+	{
+		if (auto textureIt = _textures.find(it->handle); textureIt != _textures.end())
+		{
+			render.TexFree(textureIt->second);
+			_textures.erase(textureIt);
+		}
+	}
+	_pendingFree.erase(released, _pendingFree.end());
+}
@@ -0,0 +1,397 @@
+#include "inc/video/RenderSoftware.h"
+#include <algorithm>
+#include <cmath>
+#include <future>
+
+struct RenderSoftware::Texture
+{
+	int width;
+	int height;
+	bool magFilter;
+	std::vector<SpriteColor> pixels;
+
+	SpriteColor SampleNearest(float u, float v) const
+	{
+		int x = (int)std::floor(u * (float)width) % width;
+		int y = (int)std::floor(v * (float)height) % height;
+		return pixels[(x < 0 ? x + width : x) + (y < 0 ? y + height : y) * width];
+	}
+
+	SpriteColor SampleLinear(float u, float v) const
+	{
+		float fx = u * (float)width - 0.5f;
+		float fy = v * (float)height - 0.5f;
+		float x0 = std::floor(fx);
+		float y0 = std::floor(fy);
+		int wx = (int)((fx - x0) * 256);
+		int wy = (int)((fy - y0) * 256);
+		int x = (int)x0 % width;
+		int y = (int)y0 % height;
+		if( x < 0 ) x += width;
+		if( y < 0 ) y += height;
+		int x1 = (x + 1) % width;
+		int y1 = (y + 1) % height;
+		const SpriteColor &c00 = pixels[x + y * width];
+		const SpriteColor &c10 = pixels[x1 + y * width];
+		const SpriteColor &c01 = pixels[x + y1 * width];
+		const SpriteColor &c11 = pixels[x1 + y1 * width];
+		SpriteColor result;
+		for( int i = 0; i < 4; ++i )
+		{
+			int top = c00.rgba[i] * (256 - wx) + c10.rgba[i] * wx;
+			int bottom = c01.rgba[i] * (256 - wx) + c11.rgba[i] * wx;
+			result.rgba[i] = (uint8_t)((top * (256 - wy) + bottom * wy) >> 16);
+		}
+		return result;
+	}
+};
+
+// approximates a * b / 255 for 8-bit channels
+static inline unsigned int Mul8(unsigned int a, unsigned int b)
+{
+	unsigned int t = a * b + 128;
+	return (t + (t >> 8)) >> 8;
+}
+
+// Span blending. Each function combines a run of shaded pixels with the
+// framebuffer the same way the blend states of RenderOpenGL do. The loops
+// have no dependencies between pixels so that compilers can vectorize them.
+
+// GL_SRC_ALPHA, GL_ONE, alpha channel only
+static void BlendLight(SpriteColor *dst, const SpriteColor *src, int count)
+{
+	for( int i = 0; i < count; ++i )
+		dst[i].a = (uint8_t)std::min(255u, dst[i].a + Mul8(src[i].a, src[i].a));
+}
+
+// GL_DST_ALPHA, GL_ONE_MINUS_SRC_ALPHA, color channels only
+static void BlendWorld(SpriteColor *dst, const SpriteColor *src, int count)
+{
+	for( int i = 0; i < count; ++i )
+	{
+		unsigned int light = dst[i].a;
+		unsigned int keep = 255 - src[i].a;
+		dst[i].r = (uint8_t)std::min(255u, Mul8(src[i].r, light) + Mul8(dst[i].r, keep));
+		dst[i].g = (uint8_t)std::min(255u, Mul8(src[i].g, light) + Mul8(dst[i].g, keep));
+		dst[i].b = (uint8_t)std::min(255u, Mul8(src[i].b, light) + Mul8(dst[i].b, keep));
+	}
+}
+
+// GL_ONE, GL_ONE_MINUS_SRC_ALPHA, color channels only
+static void BlendInterface(SpriteColor *dst, const SpriteColor *src, int count)
+{
+	for( int i = 0; i < count; ++i )
+	{
+		unsigned int keep = 255 - src[i].a;
+		dst[i].r = (uint8_t)std::min(255u, src[i].r + Mul8(dst[i].r, keep));
+		dst[i].g = (uint8_t)std::min(255u, src[i].g + Mul8(dst[i].g, keep));
+		dst[i].b = (uint8_t)std::min(255u, src[i].b + Mul8(dst[i].b, keep));
+	}
+}
+
+static RectRB Intersect(RectRB a, RectRB b)
+{
+	RectRB result = {
+		std::max(a.left, b.left),
+		std::max(a.top, b.top),
+		std::min(a.right, b.right),
+		std::min(a.bottom, b.bottom) };
+	result.right = std::max(result.left, result.right);
+	result.bottom = std::max(result.top, result.bottom);
+	return result;
+}
+
+RenderSoftware::RenderSoftware(unsigned int threadCount)
+	: _threadCount(std::max(1u, threadCount))
+{
+}
+
+RenderSoftware::~RenderSoftware()
+{
+}
+
+void RenderSoftware::Begin(unsigned int displayWidth, unsigned int displayHeight, DisplayOrientation displayOrientation)
+{
+	_width = displayWidth;
+	_height = displayHeight;
+	_viewport = { 0, 0, _width, _height };
+	_scissor = _viewport;
+	_offset = {};
+	_scale = 1;
+
+	_pixels.assign(_width * _height, SpriteColor(0, 0, 0, (uint8_t)(_ambient * 255)));
+
+	_vertices.clear();
+	_indices.clear();
+	_batches.clear();
+	_batchFirstVertex = 0;
+	_batchFirstIndex = 0;
+	_pendingClear = false;
+}
+
+void RenderSoftware::End()
+{
+	Flush();
+
+	if( _threadCount > 1 && _height > 1 )
+	{
+		int bandHeight = (_height + _threadCount - 1) / _threadCount;
+		std::vector<std::future<void>> bands;
+		for( int top = bandHeight; top < _height; top += bandHeight )
+		{
+			bands.push_back(std::async(std::launch::async, [this, top, bandHeight]
+			{
+				RasterizeBand(top, std::min(top + bandHeight, _height));
+			}));
+		}
+		RasterizeBand(0, std::min(bandHeight, _height));
+		for( auto &band: bands )
+			band.get();
+	}
+	else
+	{
+		RasterizeBand(0, _height);
+	}
+}
+
+ImageView RenderSoftware::GetPixels() const
+{
+	ImageView result;
+	result.pixels = _pixels.data();
+	result.width = _width;
+	result.height = _height;
+	result.stride = _width * 4;
+	result.bpp = 32;
+	return result;
+}
+
+void RenderSoftware::SetScissor(const RectRB &rect)
+{
+	Flush();
+	_scissor = rect;
+}
+
+void RenderSoftware::SetViewport(const RectRB &rect)
+{
+	Flush();
+	_viewport = rect;
+}
+
+void RenderSoftware::SetTransform(vec2d offset, float scale)
+{
+	Flush();
+	_offset = offset;
+	_scale = scale;
+}
+
+void RenderSoftware::SetMode(const RenderMode mode)
+{
+	Flush();
+	_pendingClear = RM_LIGHT == mode;
+	_mode = mode;
+}
+
+void RenderSoftware::SetAmbient(float ambient)
+{
+	_ambient = ambient;
+}
+
+bool RenderSoftware::TexCreate(DEV_TEXTURE &tex, ImageView img, bool magFilter)
+{
+	assert(24 == img.bpp || 32 == img.bpp);
+	auto texture = new Texture{ img.width, img.height, magFilter };
+	texture->pixels.resize(img.width * img.height);
+	for( int y = 0; y < img.height; ++y )
+	{
+		auto row = static_cast<const uint8_t*>(img.pixels) + y * img.stride;
+		for( int x = 0; x < img.width; ++x, row += img.bpp / 8 )
+			texture->pixels[x + y * img.width] = SpriteColor(row[0], row[1], row[2], 32 == img.bpp ? row[3] : 255);
+	}
+	tex.ptr = texture;
+	return true;
+}
+
+void RenderSoftware::TexFree(DEV_TEXTURE tex)
+{
+	delete static_cast<Texture*>(tex.ptr);
+}
+
+MyVertex* RenderSoftware::DrawQuad(DEV_TEXTURE tex)
+{
+	if( _curtex != tex.ptr )
+	{
+		Flush();
+		_curtex = static_cast<const Texture*>(tex.ptr);
+	}
+
+	auto first = (unsigned int)_vertices.size();
+	_vertices.resize(first + 4);
+	unsigned int indices[] = { first, first + 1, first + 2, first, first + 2, first + 3 };
+	_indices.insert(_indices.end(), std::begin(indices), std::end(indices));
+	return &_vertices[first];
+}
+
+MyVertex* RenderSoftware::DrawFan(unsigned int nEdges)
+{
+	auto first = (unsigned int)_vertices.size();
+	_vertices.resize(first + nEdges + 1);
+	for( unsigned int i = 0; i < nEdges; ++i )
+	{
+		_indices.push_back(first);
+		_indices.push_back(first + i + 1);
+		_indices.push_back(i + 1 < nEdges ? first + i + 2 : first + 1);
+	}
+	return &_vertices[first];
+}
+
+void RenderSoftware::Flush()
+{
+	auto indexCount = (unsigned int)_indices.size() - _batchFirstIndex;
+	if( indexCount || _pendingClear )
+	{
+		// the rest of the frame may change the transform, so bake it in now
+		for( auto i = _batchFirstVertex; i < _vertices.size(); ++i )
+		{
+			_vertices[i].x = (float)_viewport.left + _offset.x + _vertices[i].x * _scale;
+			_vertices[i].y = (float)_viewport.top + _offset.y + _vertices[i].y * _scale;
+		}
+
+		Batch batch;
+		batch.mode = _mode;
+		batch.texture = RM_LIGHT == _mode ? nullptr : _curtex;
+		batch.scissor = Intersect(_scissor, RectRB{ 0, 0, _width, _height });
+		batch.clip = Intersect(batch.scissor, _viewport);
+		batch.clearAlpha = (uint8_t)(_ambient * 255);
+		batch.clear = _pendingClear;
+		batch.firstIndex = _batchFirstIndex;
+		batch.indexCount = indexCount;
+		_batches.push_back(batch);
+
+		_pendingClear = false;
+	}
+	_batchFirstVertex = (unsigned int)_vertices.size();
+	_batchFirstIndex = (unsigned int)_indices.size();
+}
+
+void RenderSoftware::RasterizeBand(int top, int bottom)
+{
+	for( const Batch &batch: _batches )
+	{
+		RectRB band = { 0, top, _width, bottom };
+		if( batch.clear )
+		{
+			// glClear is limited by the scissor but not by the viewport
+			RectRB rect = Intersect(batch.scissor, band);
+			for( int y = rect.top; y < rect.bottom; ++y )
+				for( int x = rect.left; x < rect.right; ++x )
+					_pixels[x + y * _width].a = batch.clearAlpha;
+		}
+
+		RectRB clip = Intersect(batch.clip, band);
+		if( clip.top >= clip.bottom )
+			continue;
+
+		for( unsigned int i = 0; i < batch.indexCount; i += 3 )
+		{
+			const unsigned int *idx = &_indices[batch.firstIndex + i];
+			RasterizeTriangle(batch, _vertices[idx[0]], _vertices[idx[1]], _vertices[idx[2]], clip);
+		}
+	}
+}
+
+void RenderSoftware::RasterizeTriangle(const Batch &batch, const MyVertex &v0, const MyVertex &v1_, const MyVertex &v2_, RectRB clip)
+{
+	// edge function: positive on the inner side of the a->b edge
+	auto edge = [](const MyVertex &a, const MyVertex &b, float x, float y)
+	{
+		return (b.x - a.x) * (y - a.y) - (b.y - a.y) * (x - a.x);
+	};
+
+	float area = edge(v0, v1_, v2_.x, v2_.y);
+	if( 0 == area )
+		return;
+	bool flip = area < 0;
+	const MyVertex &v1 = flip ? v2_ : v1_;
+	const MyVertex &v2 = flip ? v1_ : v2_;
+	area = std::fabs(area);
+
+	RectRB bounds = {
+		(int)std::floor(std::min({ v0.x, v1.x, v2.x })),
+		(int)std::floor(std::min({ v0.y, v1.y, v2.y })),
+		(int)std::ceil(std::max({ v0.x, v1.x, v2.x })),
+		(int)std::ceil(std::max({ v0.y, v1.y, v2.y })) };
+	bounds = Intersect(bounds, clip);
+	if( bounds.left >= bounds.right || bounds.top >= bounds.bottom )
+		return;
+
+	// pixels exactly on a shared edge belong to one of the triangles only
+	auto topLeft = [](const MyVertex &a, const MyVertex &b)
+	{
+		float dx = b.x - a.x;
+		float dy = b.y - a.y;
+		return dy < 0 || (0 == dy && dx > 0);
+	};
+	bool tl0 = topLeft(v1, v2);
+	bool tl1 = topLeft(v2, v0);
+	bool tl2 = topLeft(v0, v1);
+
+	// per-pixel steps of the edge functions
+	float dw0dx = -(v2.y - v1.y), dw1dx = -(v0.y - v2.y), dw2dx = -(v1.y - v0.y);
+
+	void (*blend)(SpriteColor*, const SpriteColor*, int) =
+		RM_LIGHT == batch.mode ? BlendLight : RM_WORLD == batch.mode ? BlendWorld : BlendInterface;
+
+	constexpr int SPAN_SIZE = 256;
+	SpriteColor span[SPAN_SIZE];
+
+	for( int y = bounds.top; y < bounds.bottom; ++y )
+	{
+		float py = (float)y + 0.5f;
+		float px = (float)bounds.left + 0.5f;
+		float w0 = edge(v1, v2, px, py);
+		float w1 = edge(v2, v0, px, py);
+		float w2 = edge(v0, v1, px, py);
+
+		int spanStart = -1;
+		int count = 0;
+		auto flushSpan = [&]
+		{
+			if( count )
+				blend(&_pixels[spanStart + y * _width], span, count);
+			spanStart = -1;
+			count = 0;
+		};
+
+		for( int x = bounds.left; x < bounds.right; ++x, w0 += dw0dx, w1 += dw1dx, w2 += dw2dx )
+		{
+			bool inside = (w0 > 0 || (0 == w0 && tl0)) && (w1 > 0 || (0 == w1 && tl1)) && (w2 > 0 || (0 == w2 && tl2));
+			if( !inside )
+			{
+				if( spanStart >= 0 )
+					break; // triangles are convex, so the row is done
+				continue;
+			}
+
+			float b0 = w0 / area, b1 = w1 / area, b2 = w2 / area;
+			SpriteColor color;
+			for( int c = 0; c < 4; ++c )
+				color.rgba[c] = (uint8_t)(v0.color.rgba[c] * b0 + v1.color.rgba[c] * b1 + v2.color.rgba[c] * b2 + 0.5f);
+
+			if( batch.texture )
+			{
+				float u = v0.u * b0 + v1.u * b1 + v2.u * b2;
+				float v = v0.v * b0 + v1.v * b1 + v2.v * b2;
+				SpriteColor texel = batch.texture->magFilter ? batch.texture->SampleLinear(u, v) : batch.texture->SampleNearest(u, v);
+				for( int c = 0; c < 4; ++c )
+					color.rgba[c] = (uint8_t)Mul8(color.rgba[c], texel.rgba[c]);
+			}
+
+			if( spanStart < 0 )
+				spanStart = x;
+			span[count++] = color;
+			if( SPAN_SIZE == count )
+				flushSpan();
+		}
+		flushSpan();
+	}
+}
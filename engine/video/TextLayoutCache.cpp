@@ -0,0 +1,89 @@
+#include "inc/video/TextLayoutCache.h"
+#include "inc/video/TextureManager.h"
+#include <functional>
+
+void TextLayoutCache::BuildLayout(const TextureManager &tm, size_t tex, float scale, std::string_view str, Layout &layout)
+{
+	int lineCount = 0;
+	size_t maxline = 0;
+	size_t count = 0;
+	for(auto tmp = str.cbegin(); tmp != str.cend(); )
+	{
+		++count;
+		++tmp;
+		if( str.cend() == tmp || '\n' == *tmp )
+		{
+			if( maxline < count )
+				maxline = count;
+			lineCount++;
+			count = 0;
+		}
+	}
+
+	const LogicalTexture &lt = tm.GetSpriteInfo(tex);
+
+	layout.pxCharSize = Vec2dFloor(vec2d{ lt.pxFrameWidth, lt.pxFrameHeight } * scale);
+	float pxAdvance = std::floor((lt.pxFrameWidth - 1) * scale);
+	layout.pxTextSize = { pxAdvance * (float)maxline, layout.pxCharSize.y * (float)lineCount };
+
+	layout.glyphs.clear();
+	int column = 0;
+	int line = 0;
+	for(auto tmp = str.cbegin(); tmp != str.cend(); ++tmp )
+	{
+		if( '\n' == *tmp )
+		{
+			++line;
+			column = 0;
+		}
+
+		int frame = (int)(unsigned char)*tmp - lt.leadChar;
+		if( frame < 0 || frame >= lt.frameCount )
+		{
+			continue;
+		}
+
+		layout.glyphs.push_back({ vec2d{ (float)(column++) * pxAdvance, (float)line * layout.pxCharSize.y }, (unsigned int)frame });
+	}
+}
+
+const TextLayoutCache::Layout& TextLayoutCache::GetLayout(const TextureManager &tm, size_t tex, float scale, std::string_view str)
+{
+	if (_texmanVersion != tm.GetVersion())
+	{
+		_entries.clear();
+		_texmanVersion = tm.GetVersion();
+	}
+
+	size_t hash = std::hash<std::string_view>()(str) ^ (std::hash<size_t>()(tex) * 31) ^ (std::hash<float>()(scale) * 17);
+	auto range = _entries.equal_range(hash);
+	for (auto it = range.first; it != range.second; ++it)
+	{
+		Entry &entry = it->second;
+		if (entry.tex == tex && entry.scale == scale && entry.str == str)
+		{
+			entry.used = true;
+			return entry.layout;
+		}
+	}
+
+	Entry &entry = _entries.emplace(hash, Entry{ std::string(str), tex, scale, true })->second;
+	BuildLayout(tm, tex, scale, str, entry.layout);
+	return entry.layout;
+}
+
+void TextLayoutCache::EndFrame()
+{
+	for (auto it = _entries.begin(); it != _entries.end(); )
+	{
+		if (it->second.used)
+		{
+			it->second.used = false;
+			++it;
+		}
+		else
+		{
+			it = _entries.erase(it);
+		}
+	}
+}
@@ -1,6 +1,8 @@
 #pragma once
 #include "RenderBase.h"
 #include <list>
+#include <memory>
+#include <unordered_map>
 #include <vector>
 
 class TextureManager;
@@ -38,6 +40,10 @@ public:
 		return &spriteRef.descIt->uvFrames[spriteRef.firstFrameIndex];
 	}
 
+	// Images made at run time, such as map thumbnails. The device texture is created
+	// when the image is first drawn and kept until a frame goes by without drawing it.
+	DEV_TEXTURE GetImageTexture(IRender& render, const std::shared_ptr<const Image>& image);
+	void ReleaseUnusedImages(IRender& render) noexcept;
 
 private:
 	struct TexDesc
@@ -52,8 +58,16 @@ private:
 		int firstFrameIndex;
 	};
 
+	struct ImageTexture
+	{
+		std::shared_ptr<const Image> image; // keeps the key from being reused
+		DEV_TEXTURE id;
+		bool used;
+	};
+
 	std::vector<SpriteRef> _sprites;
 	std::list<TexDesc> _devTextures;
+	std::unordered_map<const Image*, ImageTexture> _images;
 	int _texmanVersion = 0;
 
 	SpriteRef& EnsureSpriteRef(size_t spriteId);
@@ -1,7 +1,10 @@
 #pragma once
 #include "RenderBase.h"
+#include "TextLayoutCache.h"
+#include <memory>
 #include <stack>
 #include <string>
+#include <vector>
 
 class RenderBinding;
 class TextureManager;
@@ -15,7 +18,9 @@ enum enumAlignText {
 class RenderContext final
 {
 public:
-	RenderContext(const TextureManager &tm, const RenderBinding &rb, IRender &render, unsigned int width, unsigned int height);
+	// text layouts are kept in textLayoutCache if one is given, otherwise measured on every draw
+	RenderContext(const TextureManager &tm, RenderBinding &rb, IRender &render, unsigned int width, unsigned int height,
+	              TextLayoutCache *textLayoutCache = nullptr);
 
 	void PushClippingRect(RectRB rect);
 	void PopClippingRect();
@@ -28,6 +33,7 @@ public:
 	float GetScale() const { return _currentTransform.scale; }
 
 	void DrawSprite(const FRECT dst, size_t sprite, SpriteColor color, unsigned int frame);
+	void DrawImage(FRECT dst, const std::shared_ptr<const Image> &image, SpriteColor color);
 	void DrawBorder(FRECT dst, size_t sprite, SpriteColor color, unsigned int frame);
 	void DrawBitmapText(vec2d origin, float scale, size_t tex, SpriteColor color, std::string_view str, enumAlignText align = alignTextLT);
 	void DrawBitmapText(FRECT rect, float scale, size_t tex, SpriteColor color, std::string_view str, enumAlignText align = alignTextLT);
@@ -35,7 +41,7 @@ public:
 	void DrawSprite(size_t tex, unsigned int frame, SpriteColor color, vec2d pos, float width, float height, vec2d dir);
 	void DrawIndicator(size_t tex, vec2d pos, float value);
 	void DrawLine(size_t tex, SpriteColor color, vec2d begin, vec2d end, float phase);
-	void DrawBackground(size_t tex, FRECT bounds) const;
+	void DrawBackground(size_t tex, FRECT bounds);
 
 	void DrawPointLight(float intensity, float radius, vec2d pos);
 	void DrawSpotLight(float intensity, float radius, vec2d pos, vec2d dir, float offset, float aspect);
@@ -44,6 +50,22 @@ public:
 	void SetAmbient(float ambient);
 	void SetMode(const RenderMode mode);
 
+	// Quads drawn while a draw list is open are recorded instead of submitted.
+	// EndDrawList submits them layer by layer, grouped by texture within each layer,
+	// so the draw order of quads from the same layer is not preserved.
+	void BeginDrawList();
+	void SetDrawLayer(unsigned int layer);
+	void EndDrawList();
+
+	struct Statistics
+	{
+		unsigned int sprites = 0;
+		unsigned int glyphs = 0;
+		unsigned int lights = 0;
+		unsigned int clipPushes = 0;
+	};
+	const Statistics& GetStatistics() const { return _statistics; }
+
 private:
 	struct Transform
 	{
@@ -52,11 +74,39 @@ private:
 		uint32_t opacity;
 		bool hardware;
 	};
+	struct DrawState
+	{
+		RectRB clip;
+		vec2d offset;
+		float scale;
+	};
+	struct DeferredQuad
+	{
+		unsigned int layer;
+		unsigned int state;
+		DEV_TEXTURE texture;
+		MyVertex v[4];
+	};
 	const TextureManager &_tm;
-	const RenderBinding &_rb;
+	RenderBinding &_rb;
 	IRender &_render;
+	TextLayoutCache *_textLayoutCache;
+	TextLayoutCache::Layout _textLayout; // used without the cache
 	std::stack<RectRB> _clipStack;
 	std::stack<Transform> _transformStack;
 	Transform _currentTransform; // local copy of _transformStack.top
 	RenderMode _mode;
+
+	bool _drawListOpen = false;
+	unsigned int _drawLayer = 0;
+	std::vector<DeferredQuad> _drawList;
+	std::vector<DrawState> _drawStates;
+
+	Statistics _statistics;
+
+	MyVertex* DrawQuad(DEV_TEXTURE tex);
+	void DrawTexturedRect(DEV_TEXTURE tex, FRECT dst, FRECT uv, SpriteColor color);
+	MyVertex* DrawFan(unsigned int nEdges);
+	void SetScissor(const RectRB &rect);
+	void SetTransform(vec2d offset, float scale);
 };
@@ -0,0 +1,42 @@
+#pragma once
+#include "RenderBase.h"
+
+struct RenderStatistics
+{
+	unsigned int quads = 0;
+	unsigned int fans = 0;
+	unsigned int vertices = 0;
+	unsigned int flushes = 0; // batches ended by texture or state changes, including the last one
+	unsigned int textureBinds = 0;
+};
+
+// Passes all calls to another renderer and counts what a frame costs
+class RenderCounting final
+	: public IRender
+{
+public:
+	explicit RenderCounting(IRender &render);
+
+	RenderStatistics GetStatistics() const;
+	void ResetStatistics();
+
+	// IRender
+	void SetScissor(const RectRB& rect) override;
+	void SetViewport(const RectRB& rect) override;
+	void SetTransform(vec2d offset, float scale) override;
+	void SetMode(const RenderMode mode) override;
+	void SetAmbient(float ambient) override;
+	bool TexCreate(DEV_TEXTURE& tex, ImageView img, bool magFilter) override;
+	void TexFree(DEV_TEXTURE tex) override;
+	MyVertex* DrawQuad(DEV_TEXTURE tex) override;
+	MyVertex* DrawFan(unsigned int nEdges) override;
+
+private:
+	IRender &_render;
+	RenderStatistics _statistics;
+	bool _batchOpen = false;
+	bool _textureBound = false;
+	DEV_TEXTURE _boundTexture = {};
+
+	void EndBatch();
+};
@@ -0,0 +1,115 @@
+#pragma once
+#include "RenderBase.h"
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+// Render commands of one frame. Once recorded it refers to nothing but the textures
+// of the recorder, so it can be played on another thread while the next frame is built.
+class RecordedFrame final
+{
+public:
+	unsigned int GetWidth() const { return _width; }
+	unsigned int GetHeight() const { return _height; }
+	bool IsEmpty() const { return _commands.empty(); }
+
+private:
+	friend class RenderRecorder;
+	friend class RenderPlayer;
+
+	enum class CommandType : uint8_t
+	{
+		Scissor,
+		Viewport,
+		Transform,
+		Ambient,
+		Mode,
+		Quads,
+		Fan,
+	};
+
+	struct Command
+	{
+		CommandType type;
+		RenderMode mode;
+		RectRB rect;
+		vec2d offset;
+		float value;             // scale or ambient
+		DEV_TEXTURE texture;
+		unsigned int count;      // quads or fan edges
+	};
+
+	unsigned int _sequence = 0;
+	unsigned int _width = 0;
+	unsigned int _height = 0;
+	DisplayOrientation _orientation = DO_0;
+	std::vector<Command> _commands;
+	std::vector<MyVertex> _vertices;
+};
+
+// Records IRender calls into a RecordedFrame.
+// Textures get handles of the recorder; RenderPlayer creates the device textures behind them.
+class RenderRecorder final
+	: public IRender
+{
+public:
+	void Begin(RecordedFrame &frame, unsigned int displayWidth, unsigned int displayHeight, DisplayOrientation displayOrientation);
+	void End();
+
+	// IRender
+	void SetScissor(const RectRB& rect) override;
+	void SetViewport(const RectRB& rect) override;
+	void SetTransform(vec2d offset, float scale) override;
+	void SetMode(const RenderMode mode) override;
+	void SetAmbient(float ambient) override;
+	bool TexCreate(DEV_TEXTURE& tex, ImageView img, bool magFilter) override;
+	void TexFree(DEV_TEXTURE tex) override;
+	MyVertex* DrawQuad(DEV_TEXTURE tex) override;
+	MyVertex* DrawFan(unsigned int nEdges) override;
+
+private:
+	friend class RenderPlayer;
+
+	struct TextureOperation
+	{
+		unsigned int handle;
+		unsigned int sequence;   // frame recorded while the operation was requested
+		bool create;
+		bool magFilter;
+		int width;
+		int height;
+		unsigned int bpp;
+		std::vector<uint8_t> pixels;
+	};
+
+	RecordedFrame *_frame = nullptr;
+	unsigned int _sequence = 0;
+	unsigned int _lastHandle = 0;
+
+	// shared with the player
+	std::mutex _textureMutex;
+	std::vector<TextureOperation> _textureOperations;
+
+	RecordedFrame::Command& AddCommand(RecordedFrame::CommandType type);
+};
+
+// Plays recorded frames into a device renderer, normally on the thread that owns the device
+class RenderPlayer final
+{
+public:
+	explicit RenderPlayer(RenderRecorder &recorder);
+
+	// the caller is responsible for Begin/End of the device renderer
+	void Play(const RecordedFrame &frame, IRender &render);
+
+	// frees every device texture, call before the device renderer goes away
+	void ReleaseTextures(IRender &render);
+
+private:
+	RenderRecorder &_recorder;
+	std::unordered_map<unsigned int, DEV_TEXTURE> _textures;
+	std::vector<RenderRecorder::TextureOperation> _pendingFree;
+
+	void UpdateTextures(IRender &render, unsigned int sequence);
+};
@@ -0,0 +1,72 @@
+#pragma once
+#include "RenderBase.h"
+#include <cstdint>
+#include <vector>
+
+// Rasterizes into an in-memory RGBA framebuffer. Needs no graphics device,
+// so it can draw on machines without a GPU.
+// Like the GPU renderers, the alpha channel of the framebuffer holds the light map.
+class RenderSoftware final
+	: public IRender
+{
+public:
+	// bands of the framebuffer are rasterized on separate threads when threadCount > 1
+	explicit RenderSoftware(unsigned int threadCount = 1);
+	~RenderSoftware() override;
+
+	void Begin(unsigned int displayWidth, unsigned int displayHeight, DisplayOrientation displayOrientation);
+	void End();
+
+	// the frame completed by the last End
+	ImageView GetPixels() const;
+
+	// IRender
+	void SetScissor(const RectRB& rect) override;
+	void SetViewport(const RectRB& rect) override;
+	void SetTransform(vec2d offset, float scale) override;
+	void SetMode(const RenderMode mode) override;
+	void SetAmbient(float ambient) override;
+	bool TexCreate(DEV_TEXTURE& tex, ImageView img, bool magFilter) override;
+	void TexFree(DEV_TEXTURE tex) override;
+	MyVertex* DrawQuad(DEV_TEXTURE tex) override;
+	MyVertex* DrawFan(unsigned int nEdges) override;
+
+private:
+	struct Texture;
+	struct Batch
+	{
+		RenderMode mode;
+		const Texture *texture;
+		RectRB scissor;
+		RectRB clip;               // framebuffer area the primitives may touch
+		uint8_t clearAlpha;        // value of the light map at the start of the batch
+		bool clear;
+		unsigned int firstIndex;
+		unsigned int indexCount;
+	};
+
+	unsigned int _threadCount;
+	int _width = 0;
+	int _height = 0;
+	std::vector<SpriteColor> _pixels;
+
+	RectRB _viewport = {};
+	RectRB _scissor = {};
+	vec2d _offset = {};
+	float _scale = 1;
+	float _ambient = 0;
+	RenderMode _mode = RM_UNDEFINED;
+	const Texture *_curtex = nullptr;
+
+	// primitives of the current frame, vertices are in framebuffer coordinates once the batch is closed
+	std::vector<MyVertex> _vertices;
+	std::vector<unsigned int> _indices;
+	std::vector<Batch> _batches;
+	unsigned int _batchFirstVertex = 0;
+	unsigned int _batchFirstIndex = 0;
+	bool _pendingClear = false;
+
+	void Flush();
+	void RasterizeBand(int top, int bottom);
+	void RasterizeTriangle(const Batch &batch, const MyVertex &v0, const MyVertex &v1, const MyVertex &v2, RectRB clip);
+};
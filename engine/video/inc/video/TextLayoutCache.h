@@ -0,0 +1,51 @@
+#pragma once
+#include <math/MyMath.h>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+class TextureManager;
+
+// Glyph layouts of the strings drawn by RenderContext::DrawBitmapText.
+// Outlives the render contexts so that text which stays the same from frame to frame
+// is measured only once.
+class TextLayoutCache final
+{
+public:
+	struct Glyph
+	{
+		vec2d offset; // from the top left corner of the text
+		unsigned int frame;
+	};
+
+	struct Layout
+	{
+		vec2d pxCharSize;
+		vec2d pxTextSize;
+		std::vector<Glyph> glyphs;
+	};
+
+	static void BuildLayout(const TextureManager &tm, size_t tex, float scale, std::string_view str, Layout &layout);
+
+	const Layout& GetLayout(const TextureManager &tm, size_t tex, float scale, std::string_view str);
+
+	// forgets the layouts that have not been used since the previous call
+	void EndFrame();
+
+	size_t GetSize() const { return _entries.size(); }
+
+private:
+	struct Entry
+	{
+		std::string str;
+		size_t tex;
+		float scale;
+		bool used;
+		Layout layout;
+	};
+
+	// by hash of the key, so that a lookup does not need to copy the string
+	std::unordered_multimap<size_t, Entry> _entries;
+	int _texmanVersion = -1;
+};
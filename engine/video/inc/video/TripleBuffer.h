@@ -0,0 +1,36 @@
+#pragma once
+#include <atomic>
+
+// Hands the latest value from one producer thread to one consumer thread without locks.
+// The producer fills the back slot and publishes it, the consumer picks up the most
+// recently published slot; values published in between are dropped.
+template <class T>
+class TripleBuffer final
+{
+public:
+	// producer
+	T& GetBack() { return _slots[_back]; }
+	void Publish()
+	{
+		_back = _ready.exchange(_back | FRESH) & INDEX_MASK;
+	}
+
+	// consumer, returns false and keeps the front slot if nothing has been published since the last call
+	bool Acquire()
+	{
+		if (!(_ready.load() & FRESH))
+			return false;
+		_front = _ready.exchange(_front) & INDEX_MASK;
+		return true;
+	}
+	T& GetFront() { return _slots[_front]; }
+
+private:
+	static constexpr unsigned int INDEX_MASK = 3;
+	static constexpr unsigned int FRESH = 4;
+
+	T _slots[3] = {};
+	unsigned int _back = 0;
+	unsigned int _front = 1;
+	std::atomic<unsigned int> _ready{ 2 };
+};
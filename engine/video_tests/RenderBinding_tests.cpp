@@ -0,0 +1,52 @@
+#include <video/EditableImage.h>
+#include <video/RenderBinding.h>
+#include <gtest/gtest.h>
+#include <memory>
+
+namespace
+{
+    struct TextureCounter final
+        : public IRender
+    {
+        int created = 0;
+        int freed = 0;
+
+        void SetScissor(const RectRB&) override {}
+        void SetViewport(const RectRB&) override {}
+        void SetTransform(vec2d, float) override {}
+        void SetMode(const RenderMode) override {}
+        void SetAmbient(float) override {}
+        bool TexCreate(DEV_TEXTURE& tex, ImageView, bool) override { tex.ptr = nullptr; tex.index = ++created; return true; }
+        void TexFree(DEV_TEXTURE) override { freed++; }
+        MyVertex* DrawQuad(DEV_TEXTURE) override { return nullptr; }
+        MyVertex* DrawFan(unsigned int) override { return nullptr; }
+    };
+}
+
+TEST(RenderBinding, ImageTextureLivesWhileDrawn)
+{
+    TextureCounter render;
+    RenderBinding rb;
+    auto image = std::make_shared<EditableImage>(2, 2);
+
+    DEV_TEXTURE tex = rb.GetImageTexture(render, image);
+    EXPECT_TRUE(tex == rb.GetImageTexture(render, image));
+    EXPECT_EQ(1, render.created);
+
+    rb.ReleaseUnusedImages(render);
+    EXPECT_EQ(0, render.freed);
+
+    rb.GetImageTexture(render, image);
+    rb.ReleaseUnusedImages(render);
+    EXPECT_EQ(1, render.created);
+    EXPECT_EQ(0, render.freed);
+
+    rb.ReleaseUnusedImages(render);
+    EXPECT_EQ(1, render.freed);
+
+    rb.GetImageTexture(render, image);
+    EXPECT_EQ(2, render.created);
+
+    rb.UnloadAllTextures(render);
+    EXPECT_EQ(2, render.freed);
+}
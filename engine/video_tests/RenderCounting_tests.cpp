@@ -0,0 +1,38 @@
+#include <video/RenderCounting.h>
+#include <video/RenderSoftware.h>
+#include <gtest/gtest.h>
+
+TEST(RenderCounting, CountsQuadsBindsAndFlushes)
+{
+    RenderSoftware software;
+    RenderCounting render(software);
+    software.Begin(8, 8, DO_0);
+
+    SpriteColor pixel = 0xffffffff;
+    DEV_TEXTURE tex1, tex2;
+    ASSERT_TRUE(render.TexCreate(tex1, { &pixel, 1, 1, 4, 32 }, false));
+    ASSERT_TRUE(render.TexCreate(tex2, { &pixel, 1, 1, 4, 32 }, false));
+
+    render.SetMode(RM_WORLD);
+    render.DrawQuad(tex1);
+    render.DrawQuad(tex1);
+    render.DrawQuad(tex2);
+    render.SetScissor({ 0, 0, 4, 4 });
+    render.DrawQuad(tex2);
+    render.SetMode(RM_LIGHT);
+    render.DrawFan(6);
+
+    RenderStatistics statistics = render.GetStatistics();
+    EXPECT_EQ(4u, statistics.quads);
+    EXPECT_EQ(1u, statistics.fans);
+    EXPECT_EQ(4u * 4 + 7, statistics.vertices);
+    EXPECT_EQ(2u, statistics.textureBinds);
+    EXPECT_EQ(4u, statistics.flushes);
+
+    render.ResetStatistics();
+    EXPECT_EQ(0u, render.GetStatistics().quads);
+    EXPECT_EQ(0u, render.GetStatistics().flushes);
+
+    render.TexFree(tex1);
+    render.TexFree(tex2);
+}
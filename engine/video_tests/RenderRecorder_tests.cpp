@@ -0,0 +1,94 @@
+#include <video/RenderCounting.h>
+#include <video/RenderRecorder.h>
+#include <video/RenderSoftware.h>
+#include <gtest/gtest.h>
+#include <cstring>
+
+static void FillQuad(MyVertex *v, float left, float top, float right, float bottom, SpriteColor color)
+{
+    v[0] = { left, top, 0, color, 0, 0 };
+    v[1] = { right, top, 0, color, 1, 0 };
+    v[2] = { right, bottom, 0, color, 1, 1 };
+    v[3] = { left, bottom, 0, color, 0, 1 };
+}
+
+static void DrawScene(IRender &render, DEV_TEXTURE red, DEV_TEXTURE green)
+{
+    render.SetAmbient(0.5f);
+    render.SetMode(RM_LIGHT);
+    MyVertex *fan = render.DrawFan(4);
+    fan[0] = { 8, 8, 0, 0xffffffff, 0, 0 };
+    FillQuad(fan + 1, 0, 0, 16, 16, 0x00000000);
+    render.SetMode(RM_WORLD);
+    render.SetTransform({ 2, 1 }, 1.5f);
+    FillQuad(render.DrawQuad(red), 0, 0, 6, 6, 0xffffffff);
+    FillQuad(render.DrawQuad(red), 5, 5, 9, 9, 0xffffffff);
+    FillQuad(render.DrawQuad(green), 2, 4, 8, 7, 0x80ffffff);
+    render.SetMode(RM_INTERFACE);
+    render.SetScissor({ 0, 0, 8, 16 });
+    FillQuad(render.DrawQuad(green), 0, 12, 16, 16, 0xffffffff);
+}
+
+TEST(RenderRecorder, PlaybackMatchesDirectRendering)
+{
+    SpriteColor redPixel(255, 0, 0, 255);
+    SpriteColor greenPixel(0, 255, 0, 255);
+
+    RenderSoftware direct;
+    direct.Begin(16, 16, DO_0);
+    DEV_TEXTURE red, green;
+    ASSERT_TRUE(direct.TexCreate(red, { &redPixel, 1, 1, 4, 32 }, false));
+    ASSERT_TRUE(direct.TexCreate(green, { &greenPixel, 1, 1, 4, 32 }, false));
+    DrawScene(direct, red, green);
+    direct.End();
+
+    RenderRecorder recorder;
+    RecordedFrame frame;
+    recorder.Begin(frame, 16, 16, DO_0);
+    ASSERT_TRUE(recorder.TexCreate(red, { &redPixel, 1, 1, 4, 32 }, false));
+    ASSERT_TRUE(recorder.TexCreate(green, { &greenPixel, 1, 1, 4, 32 }, false));
+    DrawScene(recorder, red, green);
+    recorder.End();
+    EXPECT_FALSE(frame.IsEmpty());
+
+    RenderSoftware played;
+    RenderPlayer player(recorder);
+    played.Begin(frame.GetWidth(), frame.GetHeight(), DO_0);
+    player.Play(frame, played);
+    played.End();
+    player.ReleaseTextures(played);
+
+    ImageView a = direct.GetPixels();
+    ImageView b = played.GetPixels();
+    EXPECT_EQ(0, memcmp(a.pixels, b.pixels, a.stride * a.height));
+}
+
+TEST(RenderRecorder, TexturesOutliveFramesThatUseThem)
+{
+    SpriteColor pixel = 0xffffffff;
+    RenderRecorder recorder;
+    RecordedFrame first, second;
+
+    recorder.Begin(first, 4, 4, DO_0);
+    DEV_TEXTURE tex;
+    ASSERT_TRUE(recorder.TexCreate(tex, { &pixel, 1, 1, 4, 32 }, false));
+    recorder.SetMode(RM_INTERFACE);
+    FillQuad(recorder.DrawQuad(tex), 0, 0, 4, 4, 0xffffffff);
+    recorder.End();
+
+    recorder.Begin(second, 4, 4, DO_0);
+    recorder.TexFree(tex);
+    recorder.End();
+
+    // the texture was freed while the first frame had not been played yet
+    RenderSoftware software;
+    RenderCounting counting(software);
+    RenderPlayer player(recorder);
+    software.Begin(4, 4, DO_0);
+    player.Play(first, counting);
+    EXPECT_EQ(1u, counting.GetStatistics().quads);
+    player.Play(second, counting);
+    software.End();
+
+    EXPECT_EQ(255, static_cast<const SpriteColor*>(software.GetPixels().pixels)->r);
+}
@@ -0,0 +1,129 @@
+#include <video/RenderSoftware.h>
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstring>
+
+static SpriteColor PixelAt(const RenderSoftware &render, int x, int y)
+{
+    ImageView img = render.GetPixels();
+    return static_cast<const SpriteColor*>(img.pixels)[x + y * img.width];
+}
+
+static void FillQuad(MyVertex *v, float left, float top, float right, float bottom, SpriteColor color)
+{
+    v[0] = { left, top, 0, color, 0, 0 };
+    v[1] = { right, top, 0, color, 1, 0 };
+    v[2] = { right, bottom, 0, color, 1, 1 };
+    v[3] = { left, bottom, 0, color, 0, 1 };
+}
+
+static DEV_TEXTURE CreateSolidTexture(RenderSoftware &render, SpriteColor color)
+{
+    DEV_TEXTURE tex;
+    ImageView img = { &color, 1, 1, 4, 32 };
+    EXPECT_TRUE(render.TexCreate(tex, img, false));
+    return tex;
+}
+
+TEST(RenderSoftware, BeginClearsToAmbient)
+{
+    RenderSoftware render;
+    render.SetAmbient(1);
+    render.Begin(4, 3, DO_0);
+    render.End();
+
+    ImageView img = render.GetPixels();
+    EXPECT_EQ(4, img.width);
+    EXPECT_EQ(3, img.height);
+    EXPECT_EQ(32u, img.bpp);
+    EXPECT_EQ(SpriteColor(0, 0, 0, 255).color, PixelAt(render, 3, 2).color);
+}
+
+TEST(RenderSoftware, AdjacentQuadsCoverEachPixelOnce)
+{
+    RenderSoftware render;
+    render.SetAmbient(1);
+    render.Begin(16, 16, DO_0);
+    DEV_TEXTURE white = CreateSolidTexture(render, 0xffffffff);
+    render.SetMode(RM_INTERFACE);
+    FillQuad(render.DrawQuad(white), 0, 0, 7.5f, 16, SpriteColor(128, 0, 0, 128));
+    FillQuad(render.DrawQuad(white), 7.5f, 0, 16, 16, SpriteColor(128, 0, 0, 128));
+    render.End();
+
+    for (int y = 0; y < 16; y++)
+        for (int x = 0; x < 16; x++)
+            EXPECT_EQ(128, PixelAt(render, x, y).r) << x << "," << y;
+
+    render.TexFree(white);
+}
+
+TEST(RenderSoftware, WorldIsModulatedByLight)
+{
+    RenderSoftware render;
+    render.SetAmbient(0);
+    render.Begin(8, 8, DO_0);
+    DEV_TEXTURE white = CreateSolidTexture(render, 0xffffffff);
+
+    render.SetMode(RM_LIGHT);
+    MyVertex *fan = render.DrawFan(4);
+    fan[0] = { 2, 4, 0, 0xffffffff, 0, 0 };
+    FillQuad(fan + 1, 0, 0, 4, 8, 0xffffffff);
+    render.SetMode(RM_WORLD);
+    FillQuad(render.DrawQuad(white), 0, 0, 8, 8, 0xffffffff);
+    render.End();
+
+    EXPECT_EQ(255, PixelAt(render, 1, 4).g);
+    EXPECT_EQ(0, PixelAt(render, 6, 4).g);
+
+    render.TexFree(white);
+}
+
+TEST(RenderSoftware, ScissorAndTransform)
+{
+    RenderSoftware render;
+    render.SetAmbient(1);
+    render.Begin(16, 16, DO_0);
+    DEV_TEXTURE white = CreateSolidTexture(render, 0xffffffff);
+    render.SetMode(RM_INTERFACE);
+    render.SetScissor({ 0, 0, 16, 8 });
+    render.SetTransform({ 4, 4 }, 2);
+    FillQuad(render.DrawQuad(white), 0, 0, 4, 4, 0xffffffff);
+    render.End();
+
+    EXPECT_EQ(0, PixelAt(render, 3, 5).b);
+    EXPECT_EQ(255, PixelAt(render, 4, 4).b);
+    EXPECT_EQ(255, PixelAt(render, 11, 7).b);
+    EXPECT_EQ(0, PixelAt(render, 12, 7).b);
+    EXPECT_EQ(0, PixelAt(render, 8, 8).b);
+
+    render.TexFree(white);
+}
+
+TEST(RenderSoftware, ThreadsProduceSameImage)
+{
+    auto draw = [](RenderSoftware &render)
+    {
+        render.SetAmbient(0.5f);
+        render.Begin(64, 61, DO_0);
+        DEV_TEXTURE white = CreateSolidTexture(render, 0xffffffff);
+        render.SetMode(RM_LIGHT);
+        MyVertex *fan = render.DrawFan(6);
+        fan[0] = { 32, 30, 0, 0xffffffff, 0, 0 };
+        for (int i = 1; i <= 6; i++)
+            fan[i] = { 32 + 30 * std::cos(i * 1.047f), 30 + 30 * std::sin(i * 1.047f), 0, 0x00000000, 0, 0 };
+        render.SetMode(RM_WORLD);
+        for (int i = 0; i < 10; i++)
+            FillQuad(render.DrawQuad(white), i * 5.3f, i * 3.1f, i * 5.3f + 20, i * 3.1f + 25, SpriteColor(20 * i, 255, 0, 200));
+        render.End();
+        render.TexFree(white);
+    };
+
+    RenderSoftware single;
+    draw(single);
+    RenderSoftware threaded(4);
+    draw(threaded);
+
+    ImageView a = single.GetPixels();
+    ImageView b = threaded.GetPixels();
+    EXPECT_EQ(0, memcmp(a.pixels, b.pixels, a.stride * a.height));
+}
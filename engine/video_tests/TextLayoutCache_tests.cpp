@@ -0,0 +1,43 @@
+#include <video/TextLayoutCache.h>
+#include <video/TextureManager.h>
+#include <gtest/gtest.h>
+
+using namespace std::literals;
+
+// the default sprite of TextureManager is a font of one character with code 0
+
+TEST(TextLayoutCache, LayoutMatchesMeasuredText)
+{
+    TextureManager tm;
+    TextLayoutCache cache;
+    auto text = "\0\0\n\0x"sv;
+    const TextLayoutCache::Layout &layout = cache.GetLayout(tm, 0, 4, text);
+
+    TextLayoutCache::Layout measured;
+    TextLayoutCache::BuildLayout(tm, 0, 4, text, measured);
+
+    ASSERT_EQ(3u, layout.glyphs.size());
+    EXPECT_EQ(measured.glyphs.size(), layout.glyphs.size());
+    EXPECT_EQ(measured.pxTextSize, layout.pxTextSize);
+    EXPECT_EQ((vec2d{ 4, 4 }), layout.pxCharSize);
+    EXPECT_EQ(0, layout.glyphs[1].offset.y);
+    EXPECT_EQ(4, layout.glyphs[2].offset.y);
+}
+
+TEST(TextLayoutCache, KeepsTextUsedEveryFrame)
+{
+    TextureManager tm;
+    TextLayoutCache cache;
+
+    const TextLayoutCache::Layout *score = &cache.GetLayout(tm, 0, 1, "score");
+    cache.GetLayout(tm, 0, 1, "12:00");
+    EXPECT_EQ(score, &cache.GetLayout(tm, 0, 1, "score"));
+    EXPECT_NE(score, &cache.GetLayout(tm, 0, 2, "score"));
+    EXPECT_EQ(3u, cache.GetSize());
+    cache.EndFrame();
+
+    EXPECT_EQ(score, &cache.GetLayout(tm, 0, 1, "score"));
+    cache.GetLayout(tm, 0, 1, "12:01");
+    cache.EndFrame();
+    EXPECT_EQ(2u, cache.GetSize());
+}
@@ -0,0 +1,51 @@
+#include <video/TripleBuffer.h>
+#include <gtest/gtest.h>
+#include <thread>
+
+TEST(TripleBuffer, ConsumerGetsLatestValue)
+{
+    TripleBuffer<int> buffer;
+    EXPECT_FALSE(buffer.Acquire());
+
+    buffer.GetBack() = 1;
+    buffer.Publish();
+    buffer.GetBack() = 2;
+    buffer.Publish();
+    ASSERT_TRUE(buffer.Acquire());
+    EXPECT_EQ(2, buffer.GetFront());
+    EXPECT_FALSE(buffer.Acquire());
+    EXPECT_EQ(2, buffer.GetFront());
+
+    buffer.GetBack() = 3;
+    buffer.Publish();
+    ASSERT_TRUE(buffer.Acquire());
+    EXPECT_EQ(3, buffer.GetFront());
+}
+
+TEST(TripleBuffer, ValuesNeverGoBackAcrossThreads)
+{
+    TripleBuffer<std::pair<int, int>> buffer;
+    constexpr int count = 100000;
+
+    std::thread producer([&]
+    {
+        for (int i = 1; i <= count; i++)
+        {
+            buffer.GetBack() = { i, -i };
+            buffer.Publish();
+        }
+    });
+
+    int last = 0;
+    while (last < count)
+    {
+        if (buffer.Acquire())
+        {
+            auto value = buffer.GetFront();
+            ASSERT_EQ(value.first, -value.second);
+            ASSERT_GT(value.first, last);
+            last = value.first;
+        }
+    }
+    producer.join();
+}
@@ -0,0 +1,24 @@
+#pragma once
+#include <gc/World.h>
+
+// Per-bot random numbers for the part of the AI that runs in parallel.
+// Uses the same generator as World and is reseeded from World::net_rand
+// on every step to keep the simulation deterministic.
+class AIRandom final
+{
+public:
+	void Seed(unsigned long seed) { _seed = seed; }
+
+	int Rand()
+	{
+		return ((_seed = _seed * 214013L + 2531011L) >> 16) & World::NET_RAND_MAX;
+	}
+
+	float FRand(float max)
+	{
+		return (float) Rand() / (float) World::NET_RAND_MAX * max;
+	}
+
+private:
+	unsigned long _seed = 1;
+};
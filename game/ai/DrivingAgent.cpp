@@ -1,5 +1,8 @@
 #include "DrivingAgent.h"
+#include "AIRandom.h"
 #include <gc/Field.h>
+#include <gc/FieldClusters.h>
+#include <gc/FlowFieldCache.h>
 #include <gc/SaveFile.h>
 #include <gc/Turrets.h>
 #include <gc/Vehicle.h>
@@ -8,7 +11,8 @@
 #include <gc/World.h>
 #include <gc/WorldCfg.h>
 
-#include <functional>
+#include <cassert>
+#include <queue>
 
 static void CatmullRom(const vec2d &p1, const vec2d &p2, const vec2d &p3, const vec2d &p4, vec2d &out, float s)
 {
@@ -49,8 +53,11 @@ void DrivingAgent::Serialize(SaveFile &f)
 	}
 }
 
-static constexpr int BLOCK_MULTIPLIER = 985;
-static constexpr int BLOCK_MULTIPLIER_DIAG = 1393;
+static constexpr int BLOCK_MULTIPLIER = Field::STEP_COST;
+static constexpr int BLOCK_MULTIPLIER_DIAG = Field::STEP_COST_DIAG;
+
+// paths longer than this number of clusters are planned on the cluster graph first
+static constexpr int HIERARCHICAL_PATH_MIN_CLUSTERS = 2;
 
 // neighbor nodes check order
 //    4 | 0 | 6
@@ -85,19 +92,13 @@ static int EstimatePathLength(RefFieldCell begin, RefFieldCell end)
 	return std::max(dx, dy) * BLOCK_MULTIPLIER + std::min(dx, dy) * (BLOCK_MULTIPLIER_DIAG - BLOCK_MULTIPLIER);
 }
 
-float DrivingAgent::CreatePath(World &world, vec2d from, vec2d dir, vec2d to, int team, float max_depth, bool bTest, const AIWEAPSETTINGS *ws)
+// Grid A* with turn costs. Cells outside of the area are never visited.
+// Appends path cells except the start to 'cells'; 'direction' receives the arrival direction.
+// Return: path cost or -1 if path was not found
+static int FindGridPath(Field &field, RefFieldCell startRef, int &direction, RefFieldCell endRef,
+	uint8_t passabilityMask, int distanceMultiplier, int maxRelativeDepth, const RectRB *area, std::vector<RefFieldCell> &cells)
 {
-	int maxRelativeDepth = int(max_depth * (float)BLOCK_MULTIPLIER);
-
-	auto bounds = world.GetBounds();
-	if (!PtInFRect(bounds, to))
-		return -1;
-
-	to -= Offset(bounds);
-	from -= Offset(bounds);
-
-	Field::NewSession();
-	Field &field = *world._field;
+	const unsigned int session = field.NewSession();
 
 	struct OpenListNode
 	{
@@ -116,20 +117,10 @@ float DrivingAgent::CreatePath(World &world, vec2d from, vec2d dir, vec2d to, in
 	static OpenList open;
 	open.clear();
 
-	RefFieldCell startRef = { (int)std::floor(from.x / WORLD_BLOCK_SIZE + 0.5f), (int)std::floor(from.y / WORLD_BLOCK_SIZE + 0.5f) };
-	RefFieldCell endRef = { (int)std::floor(to.x / WORLD_BLOCK_SIZE + 0.5f), (int)std::floor(to.y / WORLD_BLOCK_SIZE + 0.5f) };
-
 	FieldCell &start = field(startRef.x, startRef.y);
-
-	// if have weapon can pass through walls, turrets, etc. but now concrete or water
-	const uint8_t passabilityMask = ~(ws ? 1u : 0u);
-
-	if( start.ObstacleFlags() & passabilityMask )
-		return -1;
-
-	start.Check();
+	start.Check(session);
 	start._before = 0;
-	start._prev = int(dir.Angle() / PI2 * 8 + 0.5f) & 7;
+	start._prev = direction;
 
 	open.push({ startRef, EstimatePathLength(startRef, endRef) });
 	while( !open.empty() )
@@ -144,20 +135,23 @@ float DrivingAgent::CreatePath(World &world, vec2d from, vec2d dir, vec2d to, in
 		for( int i = 0; i < 8; ++i )
 		{
 			RefFieldCell nextRef = { currentNode.cellRef.x + per_x[i], currentNode.cellRef.y + per_y[i] };
+			if( area && (nextRef.x < area->left || nextRef.x > area->right || nextRef.y < area->top || nextRef.y > area->bottom) )
+				continue;
+
 			FieldCell &next = field(nextRef.x, nextRef.y);
 			auto nextObstacleFlags = next.ObstacleFlags();
 			if( 0 == (nextObstacleFlags & passabilityMask) )
 			{
 				// increase path cost when travel through obstacles
-				int dist_mult = nextObstacleFlags ? ws->distanceMultipler : 1;
+				int dist_mult = nextObstacleFlags ? distanceMultiplier : 1;
 
 				// total cost to 'next' including penalty for turns
 				int nextBefore = current.Before() + dist[i] * dist_mult + turn_cost[(i - current._prev) & 7];
 
 				// never visited or found a better path to node
-				if( !next.IsChecked() || nextBefore < next._before)
+				if( !next.IsChecked(session) || nextBefore < next._before)
 				{
-					next.Check();
+					next.Check(session);
 					next._before = nextBefore;
 					next._prev = i;
 
@@ -172,56 +166,463 @@ float DrivingAgent::CreatePath(World &world, vec2d from, vec2d dir, vec2d to, in
 		}
 	}
 
-	if( field(endRef.x, endRef.y).IsChecked() )
+	const FieldCell &end = field(endRef.x, endRef.y);
+	if( !end.IsChecked(session) )
+		return -1;
+
+	// trace back
+	size_t first = cells.size();
+	for( RefFieldCell currentRef = endRef; currentRef != startRef; )
+	{
+		cells.push_back(currentRef);
+		const FieldCell &current = field(currentRef.x, currentRef.y);
+		currentRef.x -= per_x[current._prev];
+		currentRef.y -= per_y[current._prev];
+	}
+	std::reverse(cells.begin() + first, cells.end());
+
+	direction = end._prev;
+	return end.Before();
+}
+
+static int DirectionIndex(int dx, int dy)
+{
+	for( int i = 0; i < 8; ++i )
+		if( per_x[i] == dx && per_y[i] == dy )
+			return i;
+	assert(false);
+	return 0;
+}
+
+static int Sign(int value)
+{
+	return (value > 0) - (value < 0);
+}
+
+// Cells of a jump point search; cells outside of the area are obstacles.
+struct JumpGrid
+{
+	const Field &field;
+	uint8_t passabilityMask;
+	const RectRB *area;
+	RefFieldCell endRef;
+
+	bool Blocked(int x, int y) const
 	{
-		float distance = (float)field(endRef.x, endRef.y).Before() / (float)BLOCK_MULTIPLIER;
+		if( area && (x < area->left || x > area->right || y < area->top || y > area->bottom) )
+			return true;
+		return 0 != (field(x, y).ObstacleFlags() & passabilityMask);
+	}
+};
 
-		if( !bTest )
+// moves from the cell in the direction until something interesting is found
+static bool Jump(const JumpGrid &grid, RefFieldCell &ref, int dx, int dy)
+{
+	for(;;)
+	{
+		ref.x += dx;
+		ref.y += dy;
+		if( grid.Blocked(ref.x, ref.y) )
+			return false;
+		if( ref == grid.endRef )
+			return true;
+
+		if( dx && dy )
 		{
-			ClearPath();
+			if( (grid.Blocked(ref.x - dx, ref.y) && !grid.Blocked(ref.x - dx, ref.y + dy)) ||
+			    (grid.Blocked(ref.x, ref.y - dy) && !grid.Blocked(ref.x + dx, ref.y - dy)) )
+				return true;
+			RefFieldCell tmp = ref;
+			if( Jump(grid, tmp, dx, 0) )
+				return true;
+			tmp = ref;
+			if( Jump(grid, tmp, 0, dy) )
+				return true;
+		}
+		else if( dx )
+		{
+			if( (grid.Blocked(ref.x, ref.y + 1) && !grid.Blocked(ref.x + dx, ref.y + 1)) ||
+			    (grid.Blocked(ref.x, ref.y - 1) && !grid.Blocked(ref.x + dx, ref.y - 1)) )
+				return true;
+		}
+		else
+		{
+			if( (grid.Blocked(ref.x + 1, ref.y) && !grid.Blocked(ref.x + 1, ref.y + dy)) ||
+			    (grid.Blocked(ref.x - 1, ref.y) && !grid.Blocked(ref.x - 1, ref.y + dy)) )
+				return true;
+		}
+	}
+}
 
-			RefFieldCell currentRef = endRef;
-			const FieldCell *current = &field(currentRef.x, currentRef.y);
+// Jump point search over cells where every passable step costs the same.
+// Straight runs are skipped without touching the open list; the turn costs
+// are applied afterwards to the cells of the found path.
+// Same contract as FindGridPath.
+static int FindJumpPointPath(Field &field, RefFieldCell startRef, int &direction, RefFieldCell endRef,
+	uint8_t passabilityMask, int maxRelativeDepth, const RectRB *area, std::vector<RefFieldCell> &cells)
+{
+	const unsigned int session = field.NewSession();
+	const JumpGrid grid = { field, passabilityMask, area, endRef };
 
-			_path.push_back(to + Offset(bounds));
+	struct OpenListNode
+	{
+		RefFieldCell cellRef;
+		int totalEstimate;
 
-			while( currentRef != startRef )
+		bool operator<(OpenListNode other) const
+		{
+			return totalEstimate > other.totalEstimate;
+		}
+	};
+	struct OpenList : public std::priority_queue<OpenListNode>
+	{
+		void clear() { c.clear(); }
+	};
+	static OpenList open;
+	open.clear();
+
+	FieldCell &start = field(startRef.x, startRef.y);
+	start.Check(session);
+	start._before = 0;
+	start._prev = -1;
+
+	open.push({ startRef, EstimatePathLength(startRef, endRef) });
+	while( !open.empty() )
+	{
+		OpenListNode currentNode = open.top();
+		if( currentNode.cellRef == endRef )
+			break;
+		open.pop();
+
+		RefFieldCell currentRef = currentNode.cellRef;
+		const FieldCell &current = field(currentRef.x, currentRef.y);
+		if( currentNode.totalEstimate > current.Before() + EstimatePathLength(currentRef, endRef) )
+			continue; // outdated entry
+
+		// natural and forced neighbors in the order of the existing direction table
+		int dirs[8][2];
+		int dirCount = 0;
+		if( current._prev < 0 )
+		{
+			for( int i = 0; i < 8; ++i, ++dirCount )
+			{
+				dirs[dirCount][0] = per_x[i];
+				dirs[dirCount][1] = per_y[i];
+			}
+		}
+		else
+		{
+			int dx = per_x[current._prev];
+			int dy = per_y[current._prev];
+			int x = currentRef.x;
+			int y = currentRef.y;
+			auto add = [&](int ndx, int ndy)
+			{
+				dirs[dirCount][0] = ndx;
+				dirs[dirCount][1] = ndy;
+				++dirCount;
+			};
+			add(dx, dy);
+			if( dx && dy )
+			{
+				add(dx, 0);
+				add(0, dy);
+				if( grid.Blocked(x - dx, y) )
+					add(-dx, dy);
+				if( grid.Blocked(x, y - dy) )
+					add(dx, -dy);
+			}
+			else if( dx )
 			{
-				// trace back
-				currentRef.x -= per_x[current->_prev];
-				currentRef.y -= per_y[current->_prev];
-				current = &field(currentRef.x, currentRef.y);
+				if( grid.Blocked(x, y + 1) )
+					add(dx, 1);
+				if( grid.Blocked(x, y - 1) )
+					add(dx, -1);
+			}
+			else
+			{
+				if( grid.Blocked(x + 1, y) )
+					add(1, dy);
+				if( grid.Blocked(x - 1, y) )
+					add(-1, dy);
+			}
+		}
+
+		for( int d = 0; d < dirCount; ++d )
+		{
+			int dx = dirs[d][0];
+			int dy = dirs[d][1];
+			RefFieldCell nextRef = currentRef;
+			if( !Jump(grid, nextRef, dx, dy) )
+				continue;
+
+			int steps = std::max(std::abs(nextRef.x - currentRef.x), std::abs(nextRef.y - currentRef.y));
+			int nextBefore = current.Before() + steps * dist[DirectionIndex(dx, dy)];
+
+			FieldCell &next = field(nextRef.x, nextRef.y);
+			if( !next.IsChecked(session) || nextBefore < next._before )
+			{
+				next.Check(session);
+				next._before = nextBefore;
+				next._prev = DirectionIndex(dx, dy);
+				field.Parent(nextRef) = currentRef;
+
+				int nextTotal = nextBefore + EstimatePathLength(nextRef, endRef);
+				if( nextTotal < maxRelativeDepth )
+					open.push({ nextRef, nextTotal });
+			}
+		}
+	}
+
+	const FieldCell &end = field(endRef.x, endRef.y);
+	if( !end.IsChecked(session) )
+		return -1;
+
+	// fill the gaps between jump points
+	size_t first = cells.size();
+	for( RefFieldCell currentRef = endRef; currentRef != startRef; )
+	{
+		RefFieldCell parentRef = field.Parent(currentRef);
+		int dx = Sign(parentRef.x - currentRef.x);
+		int dy = Sign(parentRef.y - currentRef.y);
+		for( ; currentRef != parentRef; currentRef.x += dx, currentRef.y += dy )
+			cells.push_back(currentRef);
+	}
+	std::reverse(cells.begin() + first, cells.end());
+
+	// apply the turn costs of the regular search
+	int cost = 0;
+	RefFieldCell prevRef = startRef;
+	for( size_t i = first; i < cells.size(); ++i )
+	{
+		int dir = DirectionIndex(cells[i].x - prevRef.x, cells[i].y - prevRef.y);
+		cost += dist[dir] + turn_cost[(dir - direction) & 7];
+		direction = dir;
+		prevRef = cells[i];
+	}
+	if( cost >= maxRelativeDepth )
+	{
+		cells.resize(first);
+		return -1;
+	}
+	return cost;
+}
+
+static int FindPath(Field &field, RefFieldCell startRef, int &direction, RefFieldCell endRef,
+	uint8_t passabilityMask, int distanceMultiplier, int maxRelativeDepth, const RectRB *area, std::vector<RefFieldCell> &cells)
+{
+	// nothing to shoot through, so every passable cell costs the same
+	if( 0xff == passabilityMask )
+		return FindJumpPointPath(field, startRef, direction, endRef, passabilityMask, maxRelativeDepth, area, cells);
+	return FindGridPath(field, startRef, direction, endRef, passabilityMask, distanceMultiplier, maxRelativeDepth, area, cells);
+}
 
-				for( unsigned int i = 0; i < current->GetObjectsCount(); ++i )
+float DrivingAgent::CreatePath(World &world, vec2d from, vec2d dir, vec2d to, int team, float max_depth, bool bTest, const AIWEAPSETTINGS *ws)
+{
+	int maxRelativeDepth = int(max_depth * (float)BLOCK_MULTIPLIER);
+
+	auto bounds = world.GetBounds();
+	if (!PtInFRect(bounds, to))
+		return -1;
+
+	to -= Offset(bounds);
+	from -= Offset(bounds);
+
+	Field &field = *world._field;
+
+	RefFieldCell startRef = { (int)std::floor(from.x / WORLD_BLOCK_SIZE + 0.5f), (int)std::floor(from.y / WORLD_BLOCK_SIZE + 0.5f) };
+	RefFieldCell endRef = { (int)std::floor(to.x / WORLD_BLOCK_SIZE + 0.5f), (int)std::floor(to.y / WORLD_BLOCK_SIZE + 0.5f) };
+
+	// if have weapon can pass through walls, turrets, etc. but now concrete or water
+	const uint8_t passabilityMask = ~(ws ? 1u : 0u);
+	const int distanceMultiplier = ws ? ws->distanceMultipler : 1;
+
+	if( field(startRef.x, startRef.y).ObstacleFlags() & passabilityMask )
+		return -1;
+
+	int direction = int(dir.Angle() / PI2 * 8 + 0.5f) & 7;
+	static std::vector<RefFieldCell> cells;
+	cells.assign(1, startRef);
+
+	int cost;
+	if( const FlowField *flow = field.GetFlowFields().Get(field, endRef, passabilityMask, distanceMultiplier, maxRelativeDepth) )
+	{
+		// the goal is shared with other vehicles
+		cost = flow->Trace(field, startRef, cells) ? flow->GetCost(startRef) : -1;
+	}
+	else if( FieldClusters::GetClusterDistance(startRef, endRef) < HIERARCHICAL_PATH_MIN_CLUSTERS )
+	{
+		cost = FindPath(field, startRef, direction, endRef, passabilityMask, distanceMultiplier, maxRelativeDepth, nullptr, cells);
+	}
+	else
+	{
+		// plan on the cluster graph, then refine each leg within the clusters it connects
+		FieldClusters &clusters = field.GetClusters();
+		static std::vector<RefFieldCell> waypoints;
+		const int startDirection = direction;
+		cost = clusters.FindAbstractPath(field, startRef, endRef, passabilityMask, distanceMultiplier, maxRelativeDepth, waypoints) ? 0 : -1;
+		for( size_t i = 1; i < waypoints.size() && cost >= 0; ++i )
+		{
+			RectRB area = clusters.GetClusterCells(waypoints[i - 1]);
+			RectRB nextArea = clusters.GetClusterCells(waypoints[i]);
+			area.left = std::min(area.left, nextArea.left);
+			area.top = std::min(area.top, nextArea.top);
+			area.right = std::max(area.right, nextArea.right);
+			area.bottom = std::max(area.bottom, nextArea.bottom);
+
+			int legCost = FindPath(field, waypoints[i - 1], direction, waypoints[i], passabilityMask, distanceMultiplier, maxRelativeDepth - cost, &area, cells);
+			cost = legCost < 0 ? -1 : cost + legCost;
+		}
+
+		if( cost < 0 )
+		{
+			// entrances only connect straight steps across cluster borders,
+			// so a gap that can be crossed diagonally needs the full search
+			direction = startDirection;
+			cells.assign(1, startRef);
+			cost = FindPath(field, startRef, direction, endRef, passabilityMask, distanceMultiplier, maxRelativeDepth, nullptr, cells);
+		}
+	}
+
+	if( cost < 0 )
+	{
+		// path not found
+		return -1;
+	}
+
+	if( !bTest )
+	{
+		ClearPath();
+
+		// objects on the way except for the destination cell
+		for( size_t i = cells.size() - 1; i-- > 0; )
+		{
+			const FieldCell &current = field(cells[i].x, cells[i].y);
+			for( unsigned int j = 0; j < current.GetObjectsCount(); ++j )
+			{
+				auto object = static_cast<GC_RigidBodyStatic*>(world.GetList(GlobalListID::LIST_objects).at(current.GetObject(j)));
+				if( team && !_attackFriendlyTurrets)
 				{
-					auto object = static_cast<GC_RigidBodyStatic*>(world.GetList(GlobalListID::LIST_objects).at(current->GetObject(i)));
-					if( team && !_attackFriendlyTurrets)
+					auto turret = dynamic_cast<GC_Turret*>(object);
+					if( turret && (turret->GetTeam() == team) )
 					{
-						auto turret = dynamic_cast<GC_Turret*>(object);
-						if( turret && (turret->GetTeam() == team) )
-						{
-							continue;
-						}
+						continue;
 					}
-					_attackList.push_front(object);
 				}
-
-				// skip first node, will use exact 'from' location instead
-				if( currentRef != startRef )
-					_path.push_back(vec2d{ (float)(currentRef.x * WORLD_BLOCK_SIZE), (float)(currentRef.y * WORLD_BLOCK_SIZE) } + Offset(bounds));
+				_attackList.push_front(object);
 			}
+		}
 
-			_path.push_back(from + Offset(bounds));
+		// use exact 'from' and 'to' locations instead of the first and the last nodes
+		_path.push_back(from + Offset(bounds));
+		for( size_t i = 1; i + 1 < cells.size(); ++i )
+			_path.push_back(vec2d{ (float)(cells[i].x * WORLD_BLOCK_SIZE), (float)(cells[i].y * WORLD_BLOCK_SIZE) } + Offset(bounds));
+		_path.push_back(to + Offset(bounds));
+	}
 
-			std::reverse(begin(_path), end(_path));
-			assert(startRef == currentRef);
-		}
+	return (float)cost / (float)BLOCK_MULTIPLIER;
+}
+
+void DrivingAgent::EstimatePathCosts(World &world, vec2d from, vec2d dir, const std::vector<vec2d> &goals, float max_depth, const AIWEAPSETTINGS *ws, std::vector<float> &outCosts)
+{
+	outCosts.assign(goals.size(), -1);
+
+	int maxRelativeDepth = int(max_depth * (float)BLOCK_MULTIPLIER);
 
-		return distance;
+	auto bounds = world.GetBounds();
+	from -= Offset(bounds);
+
+	struct Goal
+	{
+		RefFieldCell cellRef;
+		size_t index;
+	};
+	std::vector<Goal> pending;
+	for( size_t i = 0; i < goals.size(); ++i )
+	{
+		if( PtInFRect(bounds, goals[i]) )
+		{
+			vec2d to = goals[i] - Offset(bounds);
+			pending.push_back({ { (int)std::floor(to.x / WORLD_BLOCK_SIZE + 0.5f), (int)std::floor(to.y / WORLD_BLOCK_SIZE + 0.5f) }, i });
+		}
 	}
+	if( pending.empty() )
+		return;
+
+	Field &field = *world._field;
+	const unsigned int session = field.NewSession();
+
+	struct OpenListNode
+	{
+		RefFieldCell cellRef;
+		int before;
+
+		bool operator<(OpenListNode other) const
+		{
+			return before > other.before;
+		}
+	};
+	typedef std::priority_queue<OpenListNode> OpenList;
+	OpenList open; // owned by this query, nothing is carried over to the next one
+
+	RefFieldCell startRef = { (int)std::floor(from.x / WORLD_BLOCK_SIZE + 0.5f), (int)std::floor(from.y / WORLD_BLOCK_SIZE + 0.5f) };
+	FieldCell &start = field(startRef.x, startRef.y);
+
+	// same passability rules as in CreatePath
+	const uint8_t passabilityMask = ~(ws ? 1u : 0u);
+
+	if( start.ObstacleFlags() & passabilityMask )
+		return;
+
+	start.Check(session);
+	start._before = 0;
+	start._prev = int(dir.Angle() / PI2 * 8 + 0.5f) & 7;
+
+	// Dijkstra expansion until every goal is settled or the depth limit is reached
+	open.push({ startRef, 0 });
+	while( !open.empty() && !pending.empty() )
+	{
+		OpenListNode currentNode = open.top();
+		open.pop();
+
+		FieldCell &current = field(currentNode.cellRef.x, currentNode.cellRef.y);
+		if( currentNode.before > current.Before() )
+			continue; // outdated entry
 
-	// path not found
-	return -1;
+		for( size_t g = 0; g < pending.size(); )
+		{
+			if( pending[g].cellRef == currentNode.cellRef )
+			{
+				outCosts[pending[g].index] = (float)current.Before() / (float)BLOCK_MULTIPLIER;
+				pending[g] = pending.back();
+				pending.pop_back();
+			}
+			else
+			{
+				++g;
+			}
+		}
+
+		for( int i = 0; i < 8; ++i )
+		{
+			RefFieldCell nextRef = { currentNode.cellRef.x + per_x[i], currentNode.cellRef.y + per_y[i] };
+			FieldCell &next = field(nextRef.x, nextRef.y);
+			auto nextObstacleFlags = next.ObstacleFlags();
+			if( 0 == (nextObstacleFlags & passabilityMask) )
+			{
+				int dist_mult = nextObstacleFlags ? ws->distanceMultipler : 1;
+				int nextBefore = current.Before() + dist[i] * dist_mult + turn_cost[(i - current._prev) & 7];
+
+				if( nextBefore < maxRelativeDepth && (!next.IsChecked(session) || nextBefore < next._before) )
+				{
+					next.Check(session);
+					next._before = nextBefore;
+					next._prev = i;
+					open.push({ nextRef, nextBefore });
+				}
+			}
+		}
+	}
 }
 
 void DrivingAgent::SmoothPath()
@@ -378,6 +779,13 @@ void DrivingAgent::ClearPath()
 	_pathProgress = -1;
 	_path.clear();
 	_attackList.clear();
+	_arrived = false;
+}
+
+void DrivingAgent::ReleaseArrivedPath()
+{
+	if (_arrived)
+		ClearPath();
 }
 
 static void RotateTo(const GC_Vehicle &vehicle, VehicleState *outState, const vec2d &x, bool moveForvard, bool moveBack)
@@ -402,11 +810,8 @@ static void RotateTo(const GC_Vehicle &vehicle, VehicleState *outState, const ve
 	outState->steering = newDirection;
 }
 
-void DrivingAgent::ComputeState(World &world, const GC_Vehicle &vehicle, float dt, VehicleState &vs)
+void DrivingAgent::ComputeState(const World &world, const GC_Vehicle &vehicle, float dt, AIRandom &random, VehicleState &vs)
 {
-	// clean the attack list
-	_attackList.remove_if([](auto &arg){ return !arg; });
-
 	vec2d arrivalPoint = {};
 
 	vec2d brake = vehicle.GetBrakingLength();
@@ -417,7 +822,7 @@ void DrivingAgent::ComputeState(World &world, const GC_Vehicle &vehicle, float d
 	vec2d currentPos = vehicle.GetPos();
 //	vec2d predictedPos = GetVehicle()->GetPos() + brake;
 
-	if (!_path.empty())
+	if (!_path.empty() && !_arrived)
 	{
 //		vec2d predictedProj;
 //		auto predictedNodeIt = FindNearPathNode(predictedPos, &predictedProj, nullptr);
@@ -470,7 +875,7 @@ void DrivingAgent::ComputeState(World &world, const GC_Vehicle &vehicle, float d
 		if (++currentNodeIt == _path.end() && (currentProj - currentPos).sqr() < WORLD_BLOCK_SIZE*WORLD_BLOCK_SIZE / 16)
 		{
 			// end of path
-			ClearPath();
+			_arrived = true;
 		}
 		//else
 		//{
@@ -598,7 +1003,7 @@ void DrivingAgent::ComputeState(World &world, const GC_Vehicle &vehicle, float d
 
 	if (_backTime <= 0 && world.GetTime() - _lastProgressTime > 0.6f)
 	{
-		_backTime = world.net_frand(0.5f);
+		_backTime = random.FRand(0.5f);
 	}
 }
 
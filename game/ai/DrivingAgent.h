@@ -4,6 +4,7 @@
 #include <list>
 #include <vector>
 
+class AIRandom;
 class FieldCell;
 class SaveFile;
 class GC_RigidBodyStatic;
@@ -24,12 +25,23 @@ public:
 	// Return: path cost or -1 if path was not found
 	//-------------------------------------------------------------------------
 	float CreatePath(World &world, vec2d from, vec2d dir, vec2d to, int team, float max_depth, bool bTest, const AIWEAPSETTINGS *ws);
-	bool HasPath() const { return !_path.empty(); }
+
+	//-------------------------------------------------------------------------
+	// Evaluates path costs to several destinations with a single search.
+	//  goals        - coordinates of the arrival points
+	//  outCosts     - receives path cost per goal or -1 if the goal is unreachable
+	//-------------------------------------------------------------------------
+	static void EstimatePathCosts(World &world, vec2d from, vec2d dir, const std::vector<vec2d> &goals, float max_depth, const AIWEAPSETTINGS *ws, std::vector<float> &outCosts);
+	bool HasPath() const { return !_path.empty() && !_arrived; }
 	const std::vector<vec2d>& GetPath() const { return _path; }
 
 	// clears the current path and the attack list
 	void ClearPath();
 
+	// clears the path once ComputeState has reached its end. ComputeState may
+	// run on a worker thread, so object references are released here instead.
+	void ReleaseArrivedPath();
+
 	// create additional path nodes to make it more smooth
 	void SmoothPath();
 
@@ -38,7 +50,7 @@ public:
 
 	void StayAway(vec2d fromCenter, float radius);
 
-	void ComputeState(World &world, const GC_Vehicle &vehicle, float dt, VehicleState &vs);
+	void ComputeState(const World &world, const GC_Vehicle &vehicle, float dt, AIRandom &random, VehicleState &vs);
 	void Serialize(SaveFile &f);
 
 	void SetAttackFriendlyTurrets(bool value) { _attackFriendlyTurrets = value; }
@@ -47,6 +59,7 @@ public:
 private:
 	std::vector<vec2d> _path;
 	int _pathProgress = -1;
+	bool _arrived = false;
 	float _lastProgressTime = 0;
 
 	vec2d _stayAwayFrom = {};
@@ -1,6 +1,7 @@
 #pragma once
 #include <math/MyMath.h>
 
+class AIRandom;
 class SaveFile;
 class GC_RigidBodyStatic;
 class GC_Vehicle;
@@ -12,7 +13,7 @@ class ShootingAgent final
 {
 public:
 	void Serialize(SaveFile &f);
-	void AttackTarget(World &world, const GC_Vehicle &myVehicle, const GC_RigidBodyStatic &target, float dt, VehicleState &outVehicleState);
+	void AttackTarget(const World &world, const GC_Vehicle &myVehicle, const GC_RigidBodyStatic &target, float dt, AIRandom &random, VehicleState &outVehicleState);
 	void SetAccuracy(int accuracy);
 
 private:
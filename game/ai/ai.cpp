@@ -1,4 +1,5 @@
 #include "inc/ai/ai.h"
+#include "AIRandom.h"
 #include "DrivingAgent.h"
 #include "ShootingAgent.h"
 #include <gc/Pickup.h>
@@ -11,6 +12,7 @@
 #include <gc/WorldCfg.h>
 #include <gc/Macros.h>
 #include <gc/SaveFile.h>
+#include <algorithm>
 
 #define AI_MAX_DEPTH   256.0f
 #define AI_MAX_SIGHT_BLOCKS   40.0f
@@ -19,6 +21,7 @@
 AIController::AIController()
   : _drivingAgent(new DrivingAgent())
   , _shootingAgent(new ShootingAgent())
+  , _random(new AIRandom())
   , _favoriteWeaponType(INVALID_OBJECT_TYPE)
   , _difficulty(AIDiffuculty::Medium)
   , _isActive(true)
@@ -28,6 +31,7 @@ AIController::AIController()
 }
 
 AIController::AIController(FromFile)
+  : _random(new AIRandom())
 {
 }
 
@@ -49,23 +53,17 @@ void AIController::Serialize(SaveFile &f)
 	f.Serialize(_isActive);
 }
 
-void AIController::ReadControllerState(World &world, float dt, const GC_Vehicle &vehicle, VehicleState &outVehicleState, bool allowExtraCalc)
+void AIController::PrepareControllerState(World &world, const GC_Vehicle &vehicle, bool allowExtraCalc, unsigned long seed)
 {
-	memset(&outVehicleState, 0, sizeof(VehicleState));
+	_random->Seed(seed);
 
-	if( _pickupCurrent )
+	if( _pickupCurrent && !_pickupCurrent->GetVisible() )
 	{
-		if( !_pickupCurrent->GetVisible() )
-		{
-			_pickupCurrent = nullptr;
-		}
-		else if( (_pickupCurrent->GetPos() - vehicle.GetPos()).sqr() <
-		         std::pow(_pickupCurrent->GetRadius() + vehicle.GetRadius(), 2) )
-		{
-			outVehicleState.pickup = true;
-		}
+		_pickupCurrent = nullptr;
 	}
 
+	_drivingAgent->ReleaseArrivedPath();
+
 	AIWEAPSETTINGS weapSettings{};
 	if( vehicle.GetWeapon() )
 		vehicle.GetWeapon()->SetupAI(&weapSettings);
@@ -76,21 +74,39 @@ void AIController::ReadControllerState(World &world, float dt, const GC_Vehicle
 		SelectState(world, vehicle, vehicle.GetWeapon() ? &weapSettings : nullptr);
 
 
-	if (L1_NONE == _aiState_l1)
+	// clean the attack list
+	_drivingAgent->_attackList.remove_if([](auto &arg){ return !arg; });
+
+	if( L1_NONE == _aiState_l1 && !vehicle.GetWeapon() )
 	{
-		_drivingAgent->ComputeState(world, vehicle, dt, outVehicleState);
+		// no targets if no weapon
+		_target = nullptr;
+		_drivingAgent->_attackList.clear();
+	}
+}
 
-		if (!vehicle.GetWeapon())
-		{
-			// no targets if no weapon
-			_target = nullptr;
-			_drivingAgent->_attackList.clear();
-		}
+void AIController::ComputeControllerState(const World &world, float dt, const GC_Vehicle &vehicle, VehicleState &outVehicleState)
+{
+	memset(&outVehicleState, 0, sizeof(VehicleState));
+
+	if( _pickupCurrent && (_pickupCurrent->GetPos() - vehicle.GetPos()).sqr() <
+	                      std::pow(_pickupCurrent->GetRadius() + vehicle.GetRadius(), 2) )
+	{
+		outVehicleState.pickup = true;
+	}
+
+	AIWEAPSETTINGS weapSettings{};
+	if( vehicle.GetWeapon() )
+		vehicle.GetWeapon()->SetupAI(&weapSettings);
+
+	if (L1_NONE == _aiState_l1)
+	{
+		_drivingAgent->ComputeState(world, vehicle, dt, *_random, outVehicleState);
 
 		if (_target && IsTargetVisible(world, vehicle, _target))
 		{
 			// attack the primary target
-			_shootingAgent->AttackTarget(world, vehicle, *_target, dt, outVehicleState);
+			_shootingAgent->AttackTarget(world, vehicle, *_target, dt, *_random, outVehicleState);
 			_drivingAgent->StayAway(_target->GetPos(), weapSettings.fAttackRadius_min);
 		}
 		else
@@ -100,7 +116,7 @@ void AIController::ReadControllerState(World &world, float dt, const GC_Vehicle
 			if (!_drivingAgent->_attackList.empty() && IsTargetVisible(world, vehicle, _drivingAgent->_attackList.front()))
 			{
 				// attack secondary targets
-				_shootingAgent->AttackTarget(world, vehicle, *_drivingAgent->_attackList.front(), dt, outVehicleState);
+				_shootingAgent->AttackTarget(world, vehicle, *_drivingAgent->_attackList.front(), dt, *_random, outVehicleState);
 			}
 		}
 
@@ -122,6 +138,13 @@ void AIController::ReadControllerState(World &world, float dt, const GC_Vehicle
 	}
 }
 
+bool AIController::NeedsDecision() const
+{
+	return !_drivingAgent->HasPath() ||
+		(L2_ATTACK == _aiState_l2 && !_target) ||
+		(L2_PICKUP == _aiState_l2 && !_pickupCurrent);
+}
+
 const std::vector<vec2d>& AIController::GetPath() const
 {
 	return _drivingAgent->GetPath();
@@ -153,7 +176,9 @@ AIITEMINFO AIController::FindTarget(World &world, const GC_Vehicle &vehicle, con
 
 	std::vector<TargetDesc> targets;
 
-	FOREACH( world.GetList(LIST_vehicles), GC_Vehicle, object )
+	std::vector<GC_Vehicle*> candidates;
+	world.QueryVehicles(vehicle.GetPos(), AI_MAX_SIGHT, candidates);
+	for( GC_Vehicle *object: candidates )
 	{
 		if( !object->GetOwner() ||
 			(0 != object->GetOwner()->GetTeam() && object->GetOwner()->GetTeam() == vehicle.GetOwner()->GetTeam()) )
@@ -163,30 +188,38 @@ AIITEMINFO AIController::FindTarget(World &world, const GC_Vehicle &vehicle, con
 
 		if( object != &vehicle )
 		{
-			if( (vehicle.GetPos() - object->GetPos()).sqr() < AI_MAX_SIGHT * AI_MAX_SIGHT)
-			{
-				GC_RigidBodyStatic *pObstacle = static_cast<GC_RigidBodyStatic*>(
-					world.TraceNearest(world.grid_rigid_s, &vehicle,
-					vehicle.GetPos(), object->GetPos() - vehicle.GetPos()) );
+			GC_RigidBodyStatic *pObstacle = world.TraceNearestCached(&vehicle,
+				vehicle.GetPos(), object->GetPos() - vehicle.GetPos());
 
-				TargetDesc td;
-				td.target = object;
-				td.bIsVisible = (nullptr == pObstacle || pObstacle == object);
+			TargetDesc td;
+			td.target = object;
+			td.bIsVisible = (nullptr == pObstacle || pObstacle == object);
 
-				targets.push_back(td);
-			}
+			targets.push_back(td);
 		}
 	}
 
+	// path costs to all hidden targets are evaluated with a single search
+	std::vector<vec2d> goals;
+	for( const auto& targetDesc: targets )
+	{
+		if( !targetDesc.bIsVisible )
+			goals.push_back(targetDesc.target->GetPos());
+	}
+	std::vector<float> pathCosts;
+	if( !goals.empty() )
+		DrivingAgent::EstimatePathCosts(world, vehicle.GetPos(), vehicle.GetDirection(), goals, AI_MAX_DEPTH, ws, pathCosts);
+
 	AIITEMINFO bestTarget{};
 
+	size_t goalIndex = 0;
 	for( const auto& targetDesc: targets )
 	{
 		float l;
 		if( targetDesc.bIsVisible )
 			l = (targetDesc.target->GetPos() - vehicle.GetPos()).len() / WORLD_BLOCK_SIZE;
 		else
-			l = _drivingAgent->CreatePath(world, vehicle.GetPos(), vehicle.GetDirection(), targetDesc.target->GetPos(), vehicle.GetOwner()->GetTeam(), AI_MAX_DEPTH, true, ws);
+			l = pathCosts[goalIndex++];
 
         if( l >= 0 )
 		{
@@ -238,23 +271,31 @@ bool AIController::FindItem(World &world, const GC_Vehicle &vehicle, /*out*/ AII
 	AIPRIORITY optimal  = AIP_NOTREQUIRED;
 	GC_Pickup *pOptItem = nullptr;
 
+	if( _pickupCurrent && !_pickupCurrent->GetAttached() &&
+		applicants.end() == std::find(applicants.begin(), applicants.end(), _pickupCurrent) )
+	{
+		assert(_pickupCurrent->GetVisible());
+		applicants.push_back(_pickupCurrent);
+	}
+
 	if( !applicants.empty() )
 	{
-		GC_Pickup *items[2] = {
-			_pickupCurrent,
-			applicants[world.net_rand() % applicants.size()]
-		};
-		for( int i = 0; i < 2; ++i )
+		// a single search ranks all applicants
+		std::vector<vec2d> goals;
+		goals.reserve(applicants.size());
+		for( auto item: applicants )
+			goals.push_back(item->GetPos());
+		std::vector<float> pathCosts;
+		DrivingAgent::EstimatePathCosts(world, vehicle.GetPos(), vehicle.GetDirection(), goals, AI_MAX_DEPTH, ws, pathCosts);
+
+		for( size_t i = 0; i < applicants.size(); ++i )
 		{
-			if( nullptr == items[i] ) continue;
-			assert(items[i]->GetVisible());
-			if( items[i]->GetAttached() ) continue;
-			float l = _drivingAgent->CreatePath(world, vehicle.GetPos(), vehicle.GetDirection(), items[i]->GetPos(), vehicle.GetOwner()->GetTeam(), AI_MAX_DEPTH, true, ws);
+			float l = pathCosts[i];
 			// TODO: path cost should be non linear function of the length
 			if( l >= 0 )
 			{
-				AIPRIORITY p = items[i]->GetPriority(world, vehicle) - AIP_NORMAL * l / AI_MAX_DEPTH;
-				if( items[i]->GetType() == _favoriteWeaponType )
+				AIPRIORITY p = applicants[i]->GetPriority(world, vehicle) - AIP_NORMAL * l / AI_MAX_DEPTH;
+				if( applicants[i]->GetType() == _favoriteWeaponType )
 				{
 					if( vehicle.GetWeapon()
 						&& _favoriteWeaponType != vehicle.GetWeapon()->GetType()
@@ -265,7 +306,7 @@ bool AIController::FindItem(World &world, const GC_Vehicle &vehicle, /*out*/ AII
 				}
 				if( p > optimal )
 				{
-					pOptItem = items[i];
+					pOptItem = applicants[i];
 					optimal = p;
 				}
 			}
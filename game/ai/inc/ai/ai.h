@@ -14,6 +14,7 @@ class GC_Vehicle;
 class SaveFile;
 class World;
 
+class AIRandom;
 class DrivingAgent;
 class ShootingAgent;
 
@@ -55,7 +56,17 @@ public:
 	bool Pickup(World &world, const GC_Vehicle &vehicle, GC_Pickup *p);
 	void Stop();
 
-	void ReadControllerState(World &world, float dt, const GC_Vehicle &vehicle, VehicleState &vs, bool allowExtraCalc);
+	// Takes decisions and drops references to dead objects. Must be called
+	// for all bots in the same order on the simulation thread.
+	//  seed - random seed for ComputeControllerState, taken from World::net_rand
+	void PrepareControllerState(World &world, const GC_Vehicle &vehicle, bool allowExtraCalc, unsigned long seed);
+
+	// Computes controls for the current decision. Touches neither the world nor
+	// other controllers so different bots may be processed concurrently.
+	void ComputeControllerState(const World &world, float dt, const GC_Vehicle &vehicle, VehicleState &vs);
+
+	// true if the bot has nothing to do until it takes a new decision
+	bool NeedsDecision() const;
 
 	const std::vector<vec2d>& GetPath() const;
 
@@ -100,6 +111,7 @@ private:
 
 	std::unique_ptr<DrivingAgent> _drivingAgent;
 	std::unique_ptr<ShootingAgent> _shootingAgent;
+	std::unique_ptr<AIRandom> _random;
 
 	ObjPtr<GC_Pickup>          _pickupCurrent;
 	ObjPtr<GC_RigidBodyStatic> _target;  // current target
@@ -0,0 +1,155 @@
+#include "DrivingAgent.h"
+#include <gc/Field.h>
+#include <gc/FieldClusters.h>
+#include <gc/Wall.h>
+#include <gc/WeaponBase.h>
+#include <gc/World.h>
+#include <gc/WorldCfg.h>
+#include <gtest/gtest.h>
+#include <climits>
+
+static vec2d BlockCenter(int x, int y)
+{
+	return vec2d{ (float)x, (float)y } * WORLD_BLOCK_SIZE + vec2d{ WORLD_BLOCK_SIZE / 2, WORLD_BLOCK_SIZE / 2 };
+}
+
+static vec2d CellCenter(int x, int y)
+{
+	return vec2d{ (float)x, (float)y } * WORLD_BLOCK_SIZE;
+}
+
+TEST(DrivingAgent, CrossesClusterBorderDiagonally)
+{
+	World world({ 0, 0, 24, 8 }, true /*initField*/);
+
+	// the border between the first two clusters is open at a single corner
+	for (int y = 4; y < 8; y++)
+		world.New<GC_Wall_Concrete>(BlockCenter(6, y));
+	for (int y = 0; y < 3; y++)
+		world.New<GC_Wall_Concrete>(BlockCenter(8, y));
+
+	const Field &field = *world._field;
+	for (int y = 0; y <= 8; y++)
+		ASSERT_TRUE(field(7, y).ObstacleFlags() || field(8, y).ObstacleFlags()) << y;
+	ASSERT_EQ(0, field(7, 3).ObstacleFlags());
+	ASSERT_EQ(0, field(8, 4).ObstacleFlags());
+
+	RefFieldCell start = { 2, 2 };
+	RefFieldCell end = { 20, 5 };
+	ASSERT_LE(2, FieldClusters::GetClusterDistance(start, end));
+
+	DrivingAgent agent;
+	float cost = agent.CreatePath(world, CellCenter(start.x, start.y), vec2d{ 1, 0 }, CellCenter(end.x, end.y), 0, 100, false, nullptr);
+	EXPECT_GT(cost, 0);
+	ASSERT_TRUE(agent.HasPath());
+	EXPECT_EQ(CellCenter(end.x, end.y), agent.GetPath().back());
+}
+
+// concrete walls at fixed pseudo random blocks of a 16x16 world; any two
+// cells of such a world are less than two clusters apart
+static void BuildMaze(World &world, unsigned int seed)
+{
+	for (int y = 0; y < 16; y++)
+	{
+		for (int x = 0; x < 16; x++)
+		{
+			seed = seed * 1103515245 + 12345;
+			if ((seed >> 16) % 10 == 0)
+				world.New<GC_Wall_Concrete>(BlockCenter(x, y));
+		}
+	}
+}
+
+TEST(DrivingAgent, JumpPointSearchMatchesGridSearch)
+{
+	// only concrete walls, so the weapon settings switch the search algorithm
+	// without changing which cells are passable
+	AIWEAPSETTINGS ws{};
+	ws.distanceMultipler = 1;
+
+	for (unsigned int seed = 1; seed <= 4; seed++)
+	{
+		World world({ 0, 0, 16, 16 }, true /*initField*/);
+		BuildMaze(world, seed);
+		const Field &field = *world._field;
+
+		RefFieldCell start = { 1, 1 };
+		for (; field(start.x, start.y).ObstacleFlags(); start.x++)
+			;
+
+		// each goal is used once so that no flow field takes over
+		int reachable = 0;
+		for (int y = 1; y < 16; y++)
+		{
+			for (int x = 1; x < 16; x++)
+			{
+				if (field(x, y).ObstacleFlags() || (x == start.x && y == start.y))
+					continue;
+
+				DrivingAgent agent;
+				float jps = agent.CreatePath(world, CellCenter(start.x, start.y), vec2d{ 1, 0 }, CellCenter(x, y), 0, 1000, true, nullptr);
+				float grid = agent.CreatePath(world, CellCenter(start.x, start.y), vec2d{ 1, 0 }, CellCenter(x, y), 0, 1000, true, &ws);
+				ASSERT_EQ(grid < 0, jps < 0) << seed << ": " << x << "," << y;
+				if (grid >= 0)
+				{
+					// jump points ignore the turns, so their paths may take a few more
+					EXPECT_LE(grid, jps) << seed << ": " << x << "," << y;
+					EXPECT_GE(grid * 1.1f, jps) << seed << ": " << x << "," << y;
+					reachable++;
+				}
+			}
+		}
+		EXPECT_LT(50, reachable) << seed;
+	}
+}
+
+TEST(DrivingAgent, EstimatedCostsMatchCreatePath)
+{
+	AIWEAPSETTINGS ws{};
+	ws.distanceMultipler = 3;
+
+	for (unsigned int seed = 1; seed <= 4; seed++)
+	{
+		World world({ 0, 0, 16, 16 }, true /*initField*/);
+		BuildMaze(world, seed);
+		for (int i = 2; i < 14; i++)
+			world.New<GC_Wall>(BlockCenter(i, 7)); // brick walls the weapon can break
+		const Field &field = *world._field;
+
+		RefFieldCell start = { 8, 3 };
+		for (; field(start.x, start.y).ObstacleFlags(); start.x++)
+			;
+		vec2d from = CellCenter(start.x, start.y);
+		vec2d dir = { 0, 1 };
+		std::vector<vec2d> goals;
+		for (int y = 1; y < 16; y++)
+			for (int x = 1; x < 16; x++)
+				if (!(field(x, y).ObstacleFlags() & 0x80))
+					goals.push_back(CellCenter(x, y));
+
+		std::vector<float> costs;
+		DrivingAgent::EstimatePathCosts(world, from, dir, goals, 1000, &ws, costs);
+		std::vector<float> costsNoWeapon;
+		DrivingAgent::EstimatePathCosts(world, from, dir, goals, 1000, nullptr, costsNoWeapon);
+		ASSERT_EQ(goals.size(), costs.size());
+		ASSERT_EQ(goals.size(), costsNoWeapon.size());
+
+		// each goal is used once so that no flow field takes over
+		int reachable = 0;
+		int reachableNoWeapon = 0;
+		for (size_t i = 0; i < goals.size(); i++)
+		{
+			DrivingAgent agent;
+			EXPECT_EQ(agent.CreatePath(world, from, dir, goals[i], 0, 1000, true, &ws), costs[i]) << seed << ": " << i;
+			reachable += costs[i] >= 0;
+
+			// without a weapon CreatePath runs the jump point search which adds the turns afterwards
+			float jps = agent.CreatePath(world, from, dir, goals[i], 0, 1000, true, nullptr);
+			EXPECT_EQ(jps < 0, costsNoWeapon[i] < 0) << seed << ": " << i;
+			EXPECT_LE(costsNoWeapon[i], jps) << seed << ": " << i;
+			reachableNoWeapon += costsNoWeapon[i] >= 0;
+		}
+		EXPECT_LT(0, reachableNoWeapon) << seed;
+		EXPECT_LT(reachableNoWeapon, reachable) << seed; // through the brick walls
+	}
+}
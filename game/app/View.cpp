@@ -10,6 +10,14 @@
 
 static CounterBase counterDt("raw dt", "raw dt, ms");
 static CounterBase counterDtFiltered("dt", "dt, ms");
+static CounterBase counterQuads("quads", "Quads per frame");
+static CounterBase counterVertices("vertices", "Vertices per frame");
+static CounterBase counterFlushes("flushes", "Render flushes per frame");
+static CounterBase counterTextureBinds("texture binds", "Texture binds per frame");
+static CounterBase counterSprites("sprites", "Sprites per frame");
+static CounterBase counterGlyphs("glyphs", "Text glyphs per frame");
+static CounterBase counterLights("lights", "Lights per frame");
+static CounterBase counterClipPushes("clip pushes", "Clip pushes per frame");
 
 TzodView::TzodView(FS::FileSystem &fs, Plat::ConsoleBuffer &logger, TzodApp &app, Plat::AppWindowCommandClose *cmdClose)
 	: _impl(new TzodViewImpl(fs, cmdClose, logger, app))
@@ -25,6 +33,18 @@ void TzodView::Step(TzodApp &app, float dt, const Plat::Input &input)
 {
 	counterDt.Push(dt);
 
+	// counters of the frame rendered since the last step
+	const RenderStatistics &renderStatistics = _impl->uiInputRenderingController.GetRenderStatistics();
+	counterQuads.Push((float)renderStatistics.quads);
+	counterVertices.Push((float)renderStatistics.vertices);
+	counterFlushes.Push((float)renderStatistics.flushes);
+	counterTextureBinds.Push((float)renderStatistics.textureBinds);
+	const RenderContext::Statistics &contextStatistics = _impl->uiInputRenderingController.GetContextStatistics();
+	counterSprites.Push((float)contextStatistics.sprites);
+	counterGlyphs.Push((float)contextStatistics.glyphs);
+	counterLights.Push((float)contextStatistics.lights);
+	counterClipPushes.Push((float)contextStatistics.clipPushes);
+
 	// moving average
 	_movingAverageWindow.push_back(dt);
 	if (_movingAverageWindow.size() > 8)
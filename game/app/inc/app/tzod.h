@@ -40,6 +40,8 @@ public:
 	void SaveConfig();
 
 private:
+	void SaveMapIndex();
+
 	FS::FileSystem &_fs;
 	Plat::ConsoleBuffer &_logger;
 	std::unique_ptr<struct TzodAppImpl> _impl;
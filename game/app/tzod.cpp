@@ -11,6 +11,7 @@
 
 #define FILE_CONFIG      "user/config.cfg"
 #define FILE_DMCAMPAIGN  "dmcampaign.cfg"
+#define FILE_MAPINDEX    "user/maps.idx"
 
 static std::map<std::string, std::string> s_localizations = {
 	{"ru", "data/lang.cfg"}
@@ -65,6 +66,19 @@ TzodApp::TzodApp(FS::FileSystem &fs, Plat::ConsoleBuffer &logger, const char *la
 		}
 	}
 	setlocale(LC_CTYPE, std::string(_impl->lang.c_locale.Get()).c_str());
+
+	if (auto file = fs.Open(FILE_MAPINDEX, FS::ModeRead, true /*nothrow*/))
+	{
+		try
+		{
+			_impl->mapCollection.GetMetadataIndex().Load(*file->QueryStream());
+		}
+		catch (const std::exception &e)
+		{
+			logger.Printf(1, "Could not load map index: %s", e.what());
+		}
+	}
+	_impl->mapCollection.RefreshMetadataAsync(fs);
 }
 
 TzodApp::~TzodApp()
@@ -115,6 +129,22 @@ void TzodApp::Step(float dt)
 	{
 		SaveConfig();
 	}
+
+	_impl->mapCollection.PollMetadata();
+	if (_impl->mapCollection.GetMetadataIndex().IsDirty())
+	{
+		SaveMapIndex();
+	}
+}
+
+void TzodApp::SaveMapIndex()
+try
+{
+	_impl->mapCollection.GetMetadataIndex().Save(*_fs.Open(FILE_MAPINDEX, FS::ModeWrite)->QueryStream());
+}
+catch (const std::exception& e)
+{
+	_logger.Printf(1, "Failed to save map index: %s", e.what());
 }
 
 void TzodApp::SaveConfig()
@@ -77,7 +77,14 @@ void AppController::StartDMCampaignMap(AppState& appState, MapCollection &mapCol
 	while (appState.GetGameContext())
 		appState.PopGameContext();
 
-	auto world = mapCollection.ExtractCachedWorld(_fs, mapDesc.map_name.Get());
+	StartDMCampaignMap(appState, mapCollection.LoadWorld(_fs, mapDesc.map_name.Get()), appConfig, dmCampaign, tier, map);
+}
+
+void AppController::StartDMCampaignMap(AppState& appState, std::unique_ptr<World> world, AppConfig& appConfig, DMCampaign& dmCampaign, unsigned int tier, unsigned int map)
+{
+	while (appState.GetGameContext())
+		appState.PopGameContext();
+
 	DMSettings settings = GetCampaignDMSettings(appConfig, dmCampaign, tier, map);
 	appState.PushGameContext(std::make_shared<GameContextCampaignDM>(std::move(world), settings, tier, map));
 }
@@ -89,7 +96,7 @@ void AppController::PlayCurrentMap(AppState &appState, MapCollection& mapCollect
 
 	SaveCurrentMap(*editorContext, mapCollection);
 
-	auto world = mapCollection.ExtractCachedWorld(_fs, editorContext->GetMapName());
+	auto world = mapCollection.LoadWorld(_fs, editorContext->GetMapName());
 
 	PlayerDesc player;
 	player.nick = "Player";
@@ -5,6 +5,8 @@
 #include <MapFile.h>
 #include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <cstdio>
 
 static constexpr auto CompareMapName = [](std::string_view a, std::string_view b)
 {
@@ -17,24 +19,25 @@ static constexpr auto CompareMapName = [](std::string_view a, std::string_view b
 
 MapCollection::MapCollection(FS::FileSystem &fs)
 {
-	std::map<std::string, bool, decltype(CompareMapName)> isUserMap(CompareMapName);
+	std::map<std::string, MapFileDesc, decltype(CompareMapName)> descs(CompareMapName);
 
 	for (auto &fileName: fs.GetFileSystem(DIR_MAPS)->EnumAllFiles("*.tzod"))
 	{
 		fileName.erase(fileName.length() - 5); // remove extension
-		isUserMap.emplace(std::move(fileName), false);
+		descs.emplace(fileName, MapFileDesc{ fileName, false, true });
 	}
 
 	for (auto& fileName: fs.GetFileSystem("user")->GetFileSystem(DIR_MAPS, true /* create */)->EnumAllFiles("*.tzod"))
 	{
 		fileName.erase(fileName.length() - 5); // remove extension
-		isUserMap[std::move(fileName)] = true;
+		auto &desc = descs.emplace(fileName, MapFileDesc{ fileName, true, false }).first->second;
+		desc.user = true;
 	}
 
-	_mapDescs.reserve(isUserMap.size());
-	for (auto &m2u: isUserMap)
+	_mapDescs.reserve(descs.size());
+	for (auto &nameAndDesc: descs)
 	{
-		_mapDescs.push_back({ m2u.first, nullptr, m2u.second });
+		_mapDescs.push_back(std::move(nameAndDesc.second));
 	}
 }
 
@@ -54,23 +57,24 @@ void MapCollection::AddOrUpdateUserMap(std::string mapName)
 
 	if (insertAt != _mapDescs.end() && insertAt->mapName == mapName)
 	{
-		// override existing
+		// override existing, the metadata now comes from the user's file
 		insertAt->user = true;
-		insertAt->cachedWorld.reset();
+		auto mapIndex = static_cast<int>(std::distance(_mapDescs.begin(), insertAt));
+		for (auto* ls : _mapCollectionListeners)
+			ls->OnMapMetadataChanged(mapIndex);
 	}
 	else
 	{
 		auto newMapIndex = static_cast<int>(std::distance(_mapDescs.begin(), insertAt));
-		_mapDescs.insert(insertAt, { std::move(mapName), nullptr, true });
+		_mapDescs.insert(insertAt, { std::move(mapName), true, false });
 		for (auto* ls : _mapCollectionListeners)
 			ls->OnMapAdded(newMapIndex);
 	}
 }
 
-static std::unique_ptr<World> LoadMapUncached(FS::FileSystem& fs, std::string_view mapName)
+static std::unique_ptr<World> ImportWorld(FS::Stream &stream)
 {
-	auto stream = fs.Open(std::string(mapName) + ".tzod")->QueryStream();
-	MapFile file(*stream, false);
+	MapFile file(stream, false);
 
 	int width, height;
 	if (!file.getMapAttribute("width", width) ||
@@ -89,30 +93,98 @@ static std::unique_ptr<World> LoadMapUncached(FS::FileSystem& fs, std::string_vi
 	return world;
 }
 
-const World& MapCollection::GetCachedWorld(FS::FileSystem& fs, std::string_view mapName)
+std::unique_ptr<World> MapCollection::LoadWorld(FS::FileSystem& fs, std::string_view mapName)
 {
-	auto it = std::lower_bound(_mapDescs.begin(), _mapDescs.end(), mapName, CompareDesc);
-	assert(it != _mapDescs.end() && it->mapName == mapName);
-
-	if (!it->cachedWorld)
-		it->cachedWorld = LoadMapUncached(*(it->user ? *fs.GetFileSystem("user") : fs).GetFileSystem(DIR_MAPS, true), mapName);
-
-	return *it->cachedWorld;
+	return ImportWorld(*QueryReadStream(fs, std::string(mapName)));
 }
 
-std::unique_ptr<World> MapCollection::ExtractCachedWorld(FS::FileSystem& fs, std::string_view mapName)
+namespace
 {
-	auto it = std::lower_bound(_mapDescs.begin(), _mapDescs.end(), mapName, CompareDesc);
-	assert(it != _mapDescs.end() && it->mapName == mapName);
+	// Counts the bytes MapFile has consumed, objects are imported as they are read
+	class ProgressStream final
+		: public FS::Stream
+	{
+	public:
+		ProgressStream(FS::Stream &stream, std::atomic<long long> &bytesRead)
+			: _stream(stream)
+			, _bytesRead(bytesRead)
+		{}
+
+		size_t Read(void *dst, size_t size, size_t count) override
+		{
+			size_t result = _stream.Read(dst, size, count);
+			_bytesRead += size * result;
+			return result;
+		}
+
+		void Write(const void *src, size_t size) override
+		{
+			_stream.Write(src, size);
+		}
+
+		void Seek(long long amount, unsigned int origin) override
+		{
+			_stream.Seek(amount, origin);
+			_bytesRead = _stream.Tell();
+		}
+
+		long long Tell() const override
+		{
+			return _stream.Tell();
+		}
+
+	private:
+		FS::Stream &_stream;
+		std::atomic<long long> &_bytesRead;
+	};
+}
 
-	if (it->cachedWorld)
+std::shared_ptr<MapLoading> MapCollection::LoadWorldAsync(FS::FileSystem& fs, std::string_view mapName)
+{
+	std::shared_ptr<MapLoading> loading(new MapLoading());
+	try
 	{
-		return std::move(it->cachedWorld);
+		// the file is opened here so that the loader never touches the file system tree
+		std::shared_ptr<FS::Stream> stream = QueryReadStream(fs, std::string(mapName));
+		stream->Seek(0, SEEK_END);
+		loading->_fileSize = stream->Tell();
+		stream->Seek(0, SEEK_SET);
+
+		loading->_world = std::async(std::launch::async, [stream, &bytesRead = loading->_bytesRead]
+		{
+			ProgressStream progressStream(*stream, bytesRead);
+			return ImportWorld(progressStream);
+		});
 	}
-	else
+	catch (...)
 	{
-		return LoadMapUncached(*(it->user ? *fs.GetFileSystem("user") : fs).GetFileSystem(DIR_MAPS, true), mapName);
+		std::promise<std::unique_ptr<World>> failed;
+		failed.set_exception(std::current_exception());
+		loading->_world = failed.get_future();
 	}
+	return loading;
+}
+
+MapLoading::~MapLoading()
+{
+	if (_world.valid())
+		_world.wait();
+}
+
+float MapLoading::GetProgress() const
+{
+	return _fileSize > 0 ? std::min(1.f, (float)_bytesRead / (float)_fileSize) : 0.f;
+}
+
+bool MapLoading::IsReady() const
+{
+	return !_world.valid() || _world.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+std::unique_ptr<World> MapLoading::TakeWorld()
+{
+	assert(_world.valid());
+	return _world.get();
 }
 
 std::shared_ptr<FS::Stream> MapCollection::QueryReadStream(FS::FileSystem& fs, const std::string &mapName)
@@ -124,6 +196,51 @@ std::shared_ptr<FS::Stream> MapCollection::QueryReadStream(FS::FileSystem& fs, c
 	return mapsFolder->Open(mapName + ".tzod")->QueryStream();
 }
 
+std::string MapCollection::GetMapPath(const MapFileDesc &desc)
+{
+	return std::string(desc.user ? "user/" DIR_MAPS "/" : DIR_MAPS "/") + desc.mapName + ".tzod";
+}
+
+const MapMetadata* MapCollection::FindMapMetadata(unsigned int mapIndex) const
+{
+	return _metadataIndex.Find(GetMapPath(_mapDescs[mapIndex]));
+}
+
+const MapMetadata& MapCollection::GetMapMetadata(FS::FileSystem& fs, unsigned int mapIndex)
+{
+	return _metadataIndex.Get(fs, GetMapPath(_mapDescs[mapIndex]));
+}
+
+void MapCollection::RefreshMetadataAsync(FS::FileSystem& fs)
+{
+	std::vector<std::string> paths;
+	paths.reserve(_mapDescs.size());
+	for (auto &desc: _mapDescs)
+		paths.push_back(GetMapPath(desc));
+	_metadataIndex.RefreshAsync(fs, paths);
+}
+
+void MapCollection::PollMetadata()
+{
+	auto changed = _metadataIndex.Poll();
+	if (changed.empty())
+		return;
+
+	std::map<std::string, int, std::less<>> pathToIndex;
+	for (int mapIndex = 0; mapIndex != GetMapCount(); mapIndex++)
+		pathToIndex.emplace(GetMapPath(_mapDescs[mapIndex]), mapIndex);
+
+	for (auto &path: changed)
+	{
+		auto it = pathToIndex.find(path);
+		if (pathToIndex.end() != it)
+		{
+			for (auto* ls : _mapCollectionListeners)
+				ls->OnMapMetadataChanged(it->second);
+		}
+	}
+}
+
 MapCollectionListener::MapCollectionListener(MapCollection& mapCollection)
 	: _mapCollection(mapCollection)
 {
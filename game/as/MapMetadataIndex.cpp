@@ -0,0 +1,246 @@
+#include "inc/as/MapMetadataIndex.h"
+#include <MapFile.h>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+static constexpr uint32_t INDEX_SIGNATURE = detail::MakeSignature("mdx1");
+
+static bool IsSameFile(const FS::FileInfo &a, const FS::FileInfo &b)
+{
+	return a.size == b.size && a.modified == b.modified;
+}
+
+// Stamp of the entries read through a file system that cannot tell the file size and time.
+// Such entries are trusted until a file system that can tell finds them stale.
+static bool IsUnknownStamp(const FS::FileInfo &info)
+{
+	return IsSameFile(info, FS::FileInfo());
+}
+
+static bool IsSameMetadata(const MapMetadata &a, const MapMetadata &b)
+{
+	return a.width == b.width && a.height == b.height && a.theme == b.theme;
+}
+
+static std::pair<std::string_view, std::string_view> SplitPath(std::string_view path)
+{
+	auto pd = path.rfind('/');
+	if (std::string_view::npos == pd)
+		return { std::string_view(), path };
+	return { path.substr(0, pd), path.substr(pd + 1) };
+}
+
+template <class T>
+static void Write(FS::Stream &stream, T value)
+{
+	stream.Write(&value, sizeof(T));
+}
+
+static void WriteString(FS::Stream &stream, std::string_view value)
+{
+	assert(value.length() <= 0xffff);
+	Write<uint16_t>(stream, static_cast<uint16_t>(value.length()));
+	if (!value.empty())
+		stream.Write(value.data(), value.length());
+}
+
+template <class T>
+static T Read(FS::Stream &stream)
+{
+	T value;
+	if (1 != stream.Read(&value, sizeof(T), 1))
+		throw std::runtime_error("unexpected end of file");
+	return value;
+}
+
+static std::string ReadString(FS::Stream &stream)
+{
+	std::string value(Read<uint16_t>(stream), '\0');
+	if (!value.empty() && 1 != stream.Read(&value[0], value.length(), 1))
+		throw std::runtime_error("unexpected end of file");
+	return value;
+}
+
+MapMetadataIndex::MapMetadataIndex()
+{
+}
+
+MapMetadataIndex::~MapMetadataIndex()
+{
+	if (_refresh.valid())
+		_refresh.wait();
+}
+
+void MapMetadataIndex::Load(FS::Stream &stream)
+{
+	if (Read<uint32_t>(stream) != INDEX_SIGNATURE)
+		throw std::runtime_error("invalid map index");
+
+	std::map<std::string, Entry, std::less<>> entries;
+	for (auto count = Read<uint32_t>(stream); count; --count)
+	{
+		std::string path = ReadString(stream);
+		Entry entry;
+		entry.fileInfo.size = Read<uint64_t>(stream);
+		entry.fileInfo.modified = Read<int64_t>(stream);
+		entry.metadata.width = Read<int32_t>(stream);
+		entry.metadata.height = Read<int32_t>(stream);
+		entry.metadata.theme = ReadString(stream);
+		entries.emplace(std::move(path), std::move(entry));
+	}
+
+	_entries = std::move(entries);
+	_dirty = false;
+}
+
+void MapMetadataIndex::Save(FS::Stream &stream)
+{
+	_dirty = false; // don't retry a failed write on every call
+	Write<uint32_t>(stream, INDEX_SIGNATURE);
+	Write<uint32_t>(stream, static_cast<uint32_t>(_entries.size()));
+	for (auto &pathAndEntry: _entries)
+	{
+		const Entry &entry = pathAndEntry.second;
+		WriteString(stream, pathAndEntry.first);
+		Write<uint64_t>(stream, entry.fileInfo.size);
+		Write<int64_t>(stream, entry.fileInfo.modified);
+		Write<int32_t>(stream, entry.metadata.width);
+		Write<int32_t>(stream, entry.metadata.height);
+		WriteString(stream, entry.metadata.theme);
+	}
+}
+
+const MapMetadata* MapMetadataIndex::Find(std::string_view path) const
+{
+	auto it = _entries.find(path);
+	return _entries.end() != it ? &it->second.metadata : nullptr;
+}
+
+const MapMetadata& MapMetadataIndex::Get(FS::FileSystem &fs, std::string_view path)
+{
+	auto [dirName, fileName] = SplitPath(path);
+	auto dir = dirName.empty() ? nullptr : fs.GetFileSystem(dirName);
+	FS::FileSystem &folder = dir ? *dir : fs;
+
+	FS::FileInfo fileInfo;
+	if (!folder.GetFileInfo(fileName, fileInfo))
+		fileInfo = FS::FileInfo();
+
+	auto it = _entries.find(path);
+	if (_entries.end() != it && IsSameFile(it->second.fileInfo, fileInfo))
+		return it->second.metadata;
+
+	Entry entry = { fileInfo, ReadMetadata(folder, fileName) };
+	if (_entries.end() == it)
+	{
+		it = _entries.emplace(std::string(path), std::move(entry)).first;
+		_dirty = true;
+	}
+	else if (!IsSameFile(it->second.fileInfo, entry.fileInfo) || !IsSameMetadata(it->second.metadata, entry.metadata))
+	{
+		it->second = std::move(entry);
+		_dirty = true;
+	}
+
+	return it->second.metadata;
+}
+
+void MapMetadataIndex::RefreshAsync(FS::FileSystem &fs, const std::vector<std::string> &paths)
+{
+	if (_refresh.valid())
+		_refresh.wait();
+
+	struct Job
+	{
+		std::string path;
+		std::shared_ptr<FS::FileSystem> dir;
+		std::string fileName;
+		bool known;
+		FS::FileInfo knownFileInfo;
+	};
+
+	// Resolve the folders here so that the worker only opens plain file names
+	// and never touches the file system tree itself.
+	std::vector<Job> jobs;
+	jobs.reserve(paths.size());
+	for (auto &path: paths)
+	{
+		auto [dirName, fileName] = SplitPath(path);
+		assert(!dirName.empty());
+		if (auto dir = fs.GetFileSystem(dirName, false, true /*nothrow*/))
+		{
+			auto it = _entries.find(path);
+			bool known = _entries.end() != it;
+			jobs.push_back({ path, std::move(dir), std::string(fileName), known, known ? it->second.fileInfo : FS::FileInfo() });
+		}
+	}
+
+	_refresh = std::async(std::launch::async, [jobs = std::move(jobs)]
+	{
+		std::vector<RefreshResult> results;
+		for (auto &job: jobs)
+		{
+			RefreshResult result = { job.path, false, {} };
+			if (!job.dir->GetFileInfo(job.fileName, result.entry.fileInfo))
+				result.entry.fileInfo = FS::FileInfo();
+			if (job.known && IsSameFile(job.knownFileInfo, result.entry.fileInfo))
+				continue;
+			try
+			{
+				result.entry.metadata = ReadMetadata(*job.dir, job.fileName);
+				result.exists = true;
+			}
+			catch (const std::exception&)
+			{
+				// treat missing and unreadable maps as removed
+			}
+			if (result.exists || job.known)
+				results.push_back(std::move(result));
+		}
+		return results;
+	});
+}
+
+std::vector<std::string> MapMetadataIndex::Poll()
+{
+	std::vector<std::string> changed;
+	if (_refresh.valid() && _refresh.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+	{
+		for (auto &result: _refresh.get())
+		{
+			auto it = _entries.find(result.path);
+			if (result.exists)
+			{
+				if (_entries.end() != it && IsSameFile(it->second.fileInfo, result.entry.fileInfo) &&
+				    IsSameMetadata(it->second.metadata, result.entry.metadata))
+					continue; // already validated by Get
+				_entries[result.path] = std::move(result.entry);
+			}
+			else if (_entries.end() != it)
+			{
+				_entries.erase(it);
+			}
+			else
+			{
+				continue;
+			}
+			changed.push_back(std::move(result.path));
+		}
+		_dirty |= !changed.empty();
+	}
+	return changed;
+}
+
+MapMetadata MapMetadataIndex::ReadMetadata(FS::FileSystem &dir, std::string_view fileName)
+{
+	MapFile file(*dir.Open(fileName)->QueryStream(), false);
+
+	MapMetadata metadata;
+	file.getMapAttribute("width", metadata.width);
+	file.getMapAttribute("height", metadata.height);
+	file.getMapAttribute("theme", metadata.theme);
+	return metadata;
+}
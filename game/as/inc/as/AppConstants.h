@@ -4,3 +4,7 @@
 #define DIR_SPRITES      "sprites"
 #define DIR_MUSIC        "music"
 #define DIR_SOUND        "sounds"
+#define DIR_THUMBNAILS   "thumbnails"
+#define DIR_SAVES        "saves"
+
+#define FILE_QUICKSAVE   "quicksave.sav"
@@ -7,6 +7,7 @@ class AppConfig;
 class DMCampaign;
 class MapCollection;
 class EditorContext;
+class World;
 
 namespace FS
 {
@@ -21,6 +22,7 @@ public:
 	void Step(AppState &appState, AppConfig &appConfig, float dt, bool *outConfigChanged);
 //	void NewGameDM(TzodApp &app, const std::string &mapName, const DMSettings &settings);
 	void StartDMCampaignMap(AppState &appState, MapCollection& mapCollection, AppConfig &appConfig, DMCampaign &dmCampaign, unsigned int tier, unsigned int map);
+	void StartDMCampaignMap(AppState &appState, std::unique_ptr<World> world, AppConfig &appConfig, DMCampaign &dmCampaign, unsigned int tier, unsigned int map);
 	void PlayCurrentMap(AppState &appState, MapCollection& mapCollection);
 	void StartNewMapEditor(AppState& appState, MapCollection& mapCollection, int width, int height, std::string_view existingMapNameOptional);
 	void SaveAndExitEditor(AppState& appState, MapCollection& mapCollection);
@@ -1,4 +1,7 @@
 #pragma once
+#include "MapMetadataIndex.h"
+#include <atomic>
+#include <future>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -13,6 +16,28 @@ namespace FS
 	struct Stream;
 }
 
+// A map being imported on a background thread, see MapCollection::LoadWorldAsync.
+class MapLoading final
+{
+public:
+	~MapLoading();
+
+	// share of the map file read so far
+	float GetProgress() const;
+	bool IsReady() const;
+
+	// Waits for the loader if needed. Rethrows the error if the map could not be loaded.
+	std::unique_ptr<World> TakeWorld();
+
+private:
+	friend class MapCollection;
+	MapLoading() = default;
+
+	std::atomic<long long> _bytesRead{ 0 };
+	long long _fileSize = 0;
+	std::future<std::unique_ptr<World>> _world; // last so that it is waited for first
+};
+
 class MapCollection final
 {
 public:
@@ -21,22 +46,32 @@ public:
 
 	int GetMapCount() const { return static_cast<int>(_mapDescs.size()); }
 	std::string_view GetMapName(unsigned int mapIndex) const { return _mapDescs[mapIndex].mapName; }
+	bool IsBuiltInMap(unsigned int mapIndex) const { return _mapDescs[mapIndex].builtIn; }
 	void AddOrUpdateUserMap(std::string mapName);
 
-	const World& GetCachedWorld(FS::FileSystem& fs, std::string_view mapName);
-	std::unique_ptr<World> ExtractCachedWorld(FS::FileSystem& fs, std::string_view mapName);
+	std::unique_ptr<World> LoadWorld(FS::FileSystem& fs, std::string_view mapName);
+	// errors, including a missing file, are reported by MapLoading::TakeWorld
+	std::shared_ptr<MapLoading> LoadWorldAsync(FS::FileSystem& fs, std::string_view mapName);
 
 	std::shared_ptr<FS::Stream> QueryReadStream(FS::FileSystem& fs, const std::string &mapName);
 
+	const MapMetadata* FindMapMetadata(unsigned int mapIndex) const;
+	const MapMetadata& GetMapMetadata(FS::FileSystem& fs, unsigned int mapIndex);
+	MapMetadataIndex& GetMetadataIndex() { return _metadataIndex; }
+	void RefreshMetadataAsync(FS::FileSystem& fs);
+	void PollMetadata();
 
 private:
 	struct MapFileDesc
 	{
 		std::string mapName;
-		std::unique_ptr<World> cachedWorld;
 		bool user;
+		bool builtIn; // also shipped with the game, a user map of the same name overrides it along with its metadata
 	};
 	std::vector<MapFileDesc> _mapDescs;
+	MapMetadataIndex _metadataIndex;
+
+	static std::string GetMapPath(const MapFileDesc &desc);
 
 	std::set<class MapCollectionListener*> _mapCollectionListeners;
 	friend class MapCollectionListener;
@@ -50,7 +85,8 @@ public:
 	MapCollection& GetMapCollection() { return _mapCollection; }
 	const MapCollection& GetMapCollection() const { return _mapCollection; }
 
-	virtual void OnMapAdded(int newMapIndex) = 0;
+	virtual void OnMapAdded(int newMapIndex) {}
+	virtual void OnMapMetadataChanged(int mapIndex) {}
 
 private:
 	MapCollection& _mapCollection;
@@ -0,0 +1,59 @@
+#pragma once
+#include <fs/FileSystem.h>
+#include <future>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct MapMetadata
+{
+	int width = 0;
+	int height = 0;
+	std::string theme;
+};
+
+// Caches map header attributes keyed by file path, size and modification time
+// so that map lists don't have to open every map file.
+class MapMetadataIndex final
+{
+public:
+	MapMetadataIndex();
+	~MapMetadataIndex();
+
+	void Load(FS::Stream &stream);
+	void Save(FS::Stream &stream);
+	bool IsDirty() const { return _dirty; }
+
+	// No file access, the entry may be stale until validated.
+	const MapMetadata* Find(std::string_view path) const;
+
+	// Re-reads the map header if the file has changed since it was indexed.
+	const MapMetadata& Get(FS::FileSystem &fs, std::string_view path);
+
+	// Validates the given entries on a background thread, results are applied by Poll.
+	void RefreshAsync(FS::FileSystem &fs, const std::vector<std::string> &paths);
+
+	// Returns the paths whose metadata has changed.
+	std::vector<std::string> Poll();
+
+private:
+	struct Entry
+	{
+		FS::FileInfo fileInfo;
+		MapMetadata metadata;
+	};
+	struct RefreshResult
+	{
+		std::string path;
+		bool exists;
+		Entry entry;
+	};
+
+	std::map<std::string, Entry, std::less<>> _entries;
+	std::future<std::vector<RefreshResult>> _refresh;
+	bool _dirty = false;
+
+	static MapMetadata ReadMetadata(FS::FileSystem &dir, std::string_view fileName);
+};
@@ -0,0 +1,201 @@
+#include <as/MapMetadataIndex.h>
+#include <fs/FileSystem.h>
+#include <fsmem/FileSystemMemory.h>
+#include <gtest/gtest.h>
+#include <MapFile.h>
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <thread>
+
+namespace
+{
+	class MapFolder final : public FS::FileSystem
+	{
+	public:
+		explicit MapFolder(bool hasFileInfo) : _hasFileInfo(hasFileInfo) {}
+
+		int openCount = 0;
+
+		void SetMap(std::string fileName, int width, int height, std::string theme)
+		{
+			FS::MemoryStream stream;
+			{
+				MapFile file(stream, true /*write*/);
+				file.setMapAttribute("width", width);
+				file.setMapAttribute("height", height);
+				file.setMapAttribute("theme", theme);
+				file.BeginObject("dummy"); // the header is written with the first object
+				file.WriteCurrentObject();
+				file.WriteEndOfFile();
+			}
+
+			File &map = _files[std::move(fileName)];
+			map.data.resize((size_t)stream.Tell());
+			stream.Seek(0, SEEK_SET);
+			stream.Read(map.data.data(), map.data.size(), 1);
+			map.modified++;
+		}
+
+		// FS::FileSystem
+		bool GetFileInfo(std::string_view fileName, FS::FileInfo &info) override
+		{
+			auto it = _files.find(fileName);
+			if (!_hasFileInfo || _files.end() == it)
+				return false;
+			info.size = it->second.data.size();
+			info.modified = it->second.modified;
+			return true;
+		}
+
+	private:
+		struct File : FS::File
+		{
+			std::vector<char> data;
+			long long modified = 0;
+
+			std::shared_ptr<FS::MemMap> QueryMap() override { return nullptr; }
+			std::shared_ptr<FS::Stream> QueryStream() override
+			{
+				auto stream = std::make_shared<FS::MemoryStream>();
+				stream->Write(data.data(), data.size());
+				stream->Seek(0, SEEK_SET);
+				return stream;
+			}
+		};
+
+		bool _hasFileInfo;
+		std::map<std::string, File, std::less<>> _files;
+
+		std::shared_ptr<FS::File> RawOpen(std::string_view fileName, FS::FileMode mode, bool nothrow) override
+		{
+			auto it = _files.find(fileName);
+			if (_files.end() == it)
+			{
+				if (nothrow)
+					return nullptr;
+				throw std::runtime_error("file not found");
+			}
+			openCount++;
+			return std::shared_ptr<FS::File>(std::shared_ptr<void>(), &it->second);
+		}
+	};
+
+	struct Root final : FS::FileSystem
+	{
+		explicit Root(bool hasFileInfo)
+			: maps(std::make_shared<MapFolder>(hasFileInfo))
+		{
+			Mount("maps", maps);
+		}
+
+		std::shared_ptr<MapFolder> maps;
+
+		std::shared_ptr<FS::File> RawOpen(std::string_view fileName, FS::FileMode mode, bool nothrow) override
+		{
+			if (nothrow)
+				return nullptr;
+			throw std::runtime_error("file not found");
+		}
+	};
+}
+
+TEST(MapMetadataIndex, SaveLoadRoundTrip)
+{
+	Root fs(true /*hasFileInfo*/);
+	fs.maps->SetMap("a.tzod", 10, 20, "desert");
+	fs.maps->SetMap("b.tzod", 30, 40, "");
+
+	FS::MemoryStream stream;
+	{
+		MapMetadataIndex index;
+		index.Get(fs, "maps/a.tzod");
+		index.Get(fs, "maps/b.tzod");
+		EXPECT_TRUE(index.IsDirty());
+		index.Save(stream);
+		EXPECT_FALSE(index.IsDirty());
+	}
+
+	stream.Seek(0, SEEK_SET);
+	MapMetadataIndex index;
+	index.Load(stream);
+	EXPECT_FALSE(index.IsDirty());
+
+	const MapMetadata *a = index.Find("maps/a.tzod");
+	ASSERT_TRUE(a != nullptr);
+	EXPECT_EQ(10, a->width);
+	EXPECT_EQ(20, a->height);
+	EXPECT_EQ("desert", a->theme);
+	ASSERT_TRUE(index.Find("maps/b.tzod") != nullptr);
+	EXPECT_EQ(30, index.Find("maps/b.tzod")->width);
+	EXPECT_TRUE(index.Find("maps/c.tzod") == nullptr);
+
+	// the loaded entries are up to date, the files are not opened again
+	int openCount = fs.maps->openCount;
+	EXPECT_EQ(10, index.Get(fs, "maps/a.tzod").width);
+	EXPECT_EQ(openCount, fs.maps->openCount);
+	EXPECT_FALSE(index.IsDirty());
+}
+
+TEST(MapMetadataIndex, StaleEntryIsReadAgain)
+{
+	Root fs(true /*hasFileInfo*/);
+	fs.maps->SetMap("a.tzod", 10, 20, "desert");
+
+	MapMetadataIndex index;
+	index.Get(fs, "maps/a.tzod");
+	FS::MemoryStream stream;
+	index.Save(stream);
+
+	fs.maps->SetMap("a.tzod", 50, 60, "winter");
+	EXPECT_EQ(50, index.Get(fs, "maps/a.tzod").width);
+	EXPECT_EQ("winter", index.Get(fs, "maps/a.tzod").theme);
+	EXPECT_TRUE(index.IsDirty());
+}
+
+TEST(MapMetadataIndex, RefreshReportsStaleEntries)
+{
+	Root fs(true /*hasFileInfo*/);
+	fs.maps->SetMap("a.tzod", 10, 20, "desert");
+	fs.maps->SetMap("b.tzod", 30, 40, "");
+
+	MapMetadataIndex index;
+	index.Get(fs, "maps/a.tzod");
+	index.Get(fs, "maps/b.tzod");
+	FS::MemoryStream stream;
+	index.Save(stream);
+
+	fs.maps->SetMap("b.tzod", 70, 80, "");
+	index.RefreshAsync(fs, { "maps/a.tzod", "maps/b.tzod" });
+
+	std::vector<std::string> changed;
+	for (int attempt = 0; attempt < 5000 && changed.empty(); attempt++)
+	{
+		changed = index.Poll();
+		if (changed.empty())
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	EXPECT_EQ(std::vector<std::string>{ "maps/b.tzod" }, changed);
+	EXPECT_EQ(70, index.Find("maps/b.tzod")->width);
+	EXPECT_TRUE(index.IsDirty());
+}
+
+TEST(MapMetadataIndex, EntryWithoutFileInfoIsReadOnce)
+{
+	Root fs(false /*hasFileInfo*/);
+	fs.maps->SetMap("a.tzod", 10, 20, "desert");
+
+	MapMetadataIndex index;
+	EXPECT_EQ(10, index.Get(fs, "maps/a.tzod").width);
+	EXPECT_TRUE(index.IsDirty());
+	FS::MemoryStream stream;
+	index.Save(stream);
+
+	int openCount = fs.maps->openCount;
+	for (int frame = 0; frame < 3; frame++)
+	{
+		EXPECT_EQ(10, index.Get(fs, "maps/a.tzod").width);
+		EXPECT_FALSE(index.IsDirty());
+	}
+	EXPECT_EQ(openCount, fs.maps->openCount);
+}
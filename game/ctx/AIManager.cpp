@@ -1,8 +1,14 @@
 #include "inc/ctx/AIManager.h"
+#include "inc/ctx/WorkerPool.h"
 #include <ai/ai.h>
 #include <gc/Player.h>
 #include <gc/Vehicle.h>
 #include <gc/World.h>
+#include <algorithm>
+#include <thread>
+
+// fewer bots are not worth waking up the workers
+#define AI_MIN_PARALLEL_BOTS 8
 
 AIManager::AIManager(World &world)
 	: _world(world)
@@ -21,32 +27,113 @@ void AIManager::AssignAI(GC_Player *player, AIDiffuculty diffuculty)
 {
     std::unique_ptr<AIController> ctrl(new AIController());
 	ctrl->SetDifficulty(diffuculty);
-	_aiControllers.emplace(player, std::move(ctrl));
+	if (_aiControllers.emplace(player, std::move(ctrl)).second)
+		_decisionQueue.push_back(player);
 }
 
 AIManager::ControllerStateMap AIManager::ComputeAIState(World &world, float dt)
 {
 	ControllerStateMap result;
 
-	unsigned int numActionable = 0;
-	for (auto &ai : _aiControllers)
-		if (ai.first->GetVehicle())
-			numActionable++;
+	struct Job
+	{
+		AIController *controller;
+		const GC_Vehicle *vehicle;
+		VehicleState vs;
+	};
+	std::vector<Job> jobs;
+	std::map<GC_Player *, size_t> jobIndices;
+	// jobs and their random seeds follow the decision queue; the controllers map
+	// is ordered by player addresses which differ from run to run
+	for (GC_Player *player : _decisionQueue)
+	{
+		if (auto vehicle = player->GetVehicle())
+		{
+			jobIndices.emplace(player, jobs.size());
+			jobs.push_back({ _aiControllers[player].get(), vehicle });
+		}
+	}
 
-	if (numActionable > 0)
+	_schedulerStats = SchedulerStats();
+
+	if (!jobs.empty())
 	{
-		unsigned int favorite = world.net_rand() % numActionable;
-		unsigned int index = 0;
-		for (auto &ai : _aiControllers)
+		// Idle bots are served first, then at most one routine re-evaluation. The
+		// number of decisions is fixed before the first one from the measured cost.
+		_schedulerStats.allowed = 1;
+		if (_decisionCost > 0)
+			_schedulerStats.allowed = (unsigned int) std::max(1.0f, std::min((float) jobs.size(), (float) _decisionBudget.count() / _decisionCost));
+
+		std::vector<bool> prepared(jobs.size());
+		std::vector<GC_Player *> served;
+		auto startTime = std::chrono::steady_clock::now();
+		for (int pass = 0; pass < 2; pass++)
 		{
-			if (auto vehicle = ai.first->GetVehicle())
+			bool idle = (0 == pass);
+			for (auto it = _decisionQueue.begin(); it != _decisionQueue.end(); )
 			{
-				VehicleState vs;
-				ai.second->ReadControllerState(world, dt, *vehicle, vs, index == favorite);
-				result.insert(std::make_pair(vehicle->GetId(), vs));
-				index++;
+				auto jobIndex = jobIndices.find(*it);
+				if (jobIndices.end() == jobIndex || jobs[jobIndex->second].controller->NeedsDecision() != idle)
+				{
+					++it;
+					continue;
+				}
+
+				bool budgetSpent = _schedulerStats.decisions > 0 &&
+					(!idle || _schedulerStats.decisions >= _schedulerStats.allowed);
+				if (budgetSpent)
+				{
+					if (idle)
+						_schedulerStats.deferred++;
+					++it;
+					continue;
+				}
+
+				Job &job = jobs[jobIndex->second];
+				job.controller->PrepareControllerState(world, *job.vehicle, true, world.net_rand());
+				prepared[jobIndex->second] = true;
+				_schedulerStats.decisions++;
+
+				served.push_back(*it);
+				it = _decisionQueue.erase(it);
+
+				if (!idle)
+					break;
 			}
 		}
+		_decisionQueue.insert(_decisionQueue.end(), served.begin(), served.end());
+		auto elapsed = std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - startTime);
+		_schedulerStats.elapsed = std::chrono::duration_cast<std::chrono::microseconds>(elapsed);
+		if (_schedulerStats.decisions > 0)
+		{
+			float cost = elapsed.count() / _schedulerStats.decisions;
+			_decisionCost = _decisionCost > 0 ? (_decisionCost * 3 + cost) / 4 : cost;
+		}
+
+		for (size_t index = 0; index < jobs.size(); index++)
+		{
+			if (!prepared[index])
+				jobs[index].controller->PrepareControllerState(world, *jobs[index].vehicle, false, world.net_rand());
+		}
+
+		auto compute = [&](size_t index)
+		{
+			jobs[index].controller->ComputeControllerState(world, dt, *jobs[index].vehicle, jobs[index].vs);
+		};
+		if (jobs.size() >= AI_MIN_PARALLEL_BOTS)
+		{
+			if (!_workers)
+				_workers = std::make_unique<WorkerPool>(std::max(1u, std::thread::hardware_concurrency()) - 1);
+			_workers->ParallelFor(jobs.size(), compute);
+		}
+		else
+		{
+			for (size_t index = 0; index < jobs.size(); index++)
+				compute(index);
+		}
+
+		for (auto &job: jobs)
+			result.insert(std::make_pair(job.vehicle->GetId(), job.vs));
 	}
 	return result;
 }
@@ -77,6 +164,7 @@ void AIManager::OnKill(GC_Object &obj)
 	if (GC_Player::GetTypeStatic() == obj.GetType())
 	{
 		_aiControllers.erase(static_cast<GC_Player *>(&obj));
+		_decisionQueue.erase(std::remove(_decisionQueue.begin(), _decisionQueue.end(), static_cast<GC_Player *>(&obj)), _decisionQueue.end());
 	}
 }
 
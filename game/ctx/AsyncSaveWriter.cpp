@@ -0,0 +1,61 @@
+#include "inc/ctx/AsyncSaveWriter.h"
+#include <fs/FileSystem.h>
+#include <chrono>
+
+AsyncSaveWriter::AsyncSaveWriter()
+{
+}
+
+AsyncSaveWriter::~AsyncSaveWriter()
+{
+	for (auto &job: _jobs)
+		job.result.wait();
+}
+
+void AsyncSaveWriter::Enqueue(std::vector<char> data, std::shared_ptr<FS::Stream> stream, CompletionCallback onComplete)
+{
+	// Writes into the same stream must not overlap, so each job waits for the previous one.
+	std::shared_future<void> previous;
+	if (!_jobs.empty())
+		previous = _jobs.back().result;
+
+	Job job;
+	job.onComplete = std::move(onComplete);
+	job.result = std::async(std::launch::async, [data = std::move(data), stream = std::move(stream), previous]
+	{
+		if (previous.valid())
+			previous.wait();
+		if (!data.empty())
+			stream->Write(data.data(), data.size());
+	}).share();
+	_jobs.push_back(std::move(job));
+}
+
+void AsyncSaveWriter::Poll()
+{
+	// Complete in submission order so the callbacks observe saves the way they were requested
+	while (!_jobs.empty() && _jobs.front().result.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+	{
+		Job job = std::move(_jobs.front());
+		_jobs.pop_front();
+
+		std::exception_ptr error;
+		try
+		{
+			job.result.get();
+		}
+		catch (...)
+		{
+			error = std::current_exception();
+		}
+		if (job.onComplete)
+			job.onComplete(error);
+	}
+}
+
+void AsyncSaveWriter::WaitAll()
+{
+	for (auto &job: _jobs)
+		job.result.wait();
+	Poll();
+}
@@ -9,6 +9,52 @@
 #include <gc/WorldCfg.h>
 #include <script/ScriptHarness.h>
 #include <climits>
+#include <cstdio>
+#include <cstring>
+
+namespace
+{
+	class SnapshotStream final : public FS::Stream
+	{
+	public:
+		std::vector<char>& GetData() { return _data; }
+
+		// FS::Stream
+		size_t Read(void *dst, size_t size, size_t count) override
+		{
+			return 0;
+		}
+
+		void Write(const void *src, size_t size) override
+		{
+			if (_data.size() - _pos < size)
+				_data.resize(_pos + size);
+			memcpy(_data.data() + _pos, src, size);
+			_pos += size;
+		}
+
+		void Seek(long long amount, unsigned int origin) override
+		{
+			switch (origin)
+			{
+			case SEEK_SET: _pos = static_cast<size_t>(amount); break;
+			case SEEK_CUR: _pos += static_cast<size_t>(amount); break;
+			case SEEK_END: _pos = _data.size() + static_cast<size_t>(amount); break;
+			}
+			if (_pos > _data.size())
+				_data.resize(_pos);
+		}
+
+		long long Tell() const override
+		{
+			return (long long)_pos;
+		}
+
+	private:
+		std::vector<char> _data;
+		size_t _pos = 0;
+	};
+}
 
 GameContext::GameContext(std::unique_ptr<World> world, const DMSettings &settings)
 	: _world(std::move(world))
@@ -62,6 +108,8 @@ Gameplay* GameContext::GetGameplay() const
 
 void GameContext::Step(float dt, AppConfig &appConfig, bool *outConfigChanged)
 {
+	_saveWriter.Poll();
+
 	if (IsGameplayActive())
 		_gameplayTime += dt;
 
@@ -102,6 +150,13 @@ void GameContext::Serialize(FS::Stream &stream)
 	_scriptHarness->Serialize(f);
 }
 
+void GameContext::SerializeAsync(std::shared_ptr<FS::Stream> stream, AsyncSaveWriter::CompletionCallback onComplete)
+{
+	SnapshotStream snapshot;
+	Serialize(snapshot);
+	_saveWriter.Enqueue(std::move(snapshot.GetData()), std::move(stream), std::move(onComplete));
+}
+
 void GameContext::Deserialize(FS::Stream &stream)
 {
 	SaveFile f(stream, true);
@@ -0,0 +1,71 @@
+#include "inc/ctx/WorkerPool.h"
+
+WorkerPool::WorkerPool(unsigned int workerCount)
+{
+	for (unsigned int i = 0; i < workerCount; i++)
+		_threads.emplace_back(&WorkerPool::WorkerMain, this);
+}
+
+WorkerPool::~WorkerPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_exit = true;
+	}
+	_wake.notify_all();
+	for (auto &thread: _threads)
+		thread.join();
+}
+
+void WorkerPool::ParallelFor(size_t count, const std::function<void(size_t)> &func)
+{
+	if (_threads.empty() || count < 2)
+	{
+		for (size_t i = 0; i < count; i++)
+			func(i);
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_func = &func;
+		_count = count;
+		_next = 0;
+		_busyWorkers = (unsigned int) _threads.size();
+		_generation++;
+	}
+	_wake.notify_all();
+
+	RunItems();
+
+	std::unique_lock<std::mutex> lock(_mutex);
+	_done.wait(lock, [this] { return 0 == _busyWorkers; });
+	_func = nullptr;
+}
+
+void WorkerPool::WorkerMain()
+{
+	unsigned int generation = 0;
+	for (;;)
+	{
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_wake.wait(lock, [&] { return _exit || _generation != generation; });
+			if (_exit)
+				return;
+			generation = _generation;
+		}
+
+		RunItems();
+
+		std::lock_guard<std::mutex> lock(_mutex);
+		if (0 == --_busyWorkers)
+			_done.notify_one();
+	}
+}
+
+void WorkerPool::RunItems()
+{
+	for (size_t i = _next++; i < _count; i = _next++)
+		(*_func)(i);
+}
@@ -2,6 +2,8 @@
 #include <gc/WorldEvents.h>
 #include <gc/detail/PtrList.h>
 
+#include <chrono>
+#include <deque>
 #include <map>
 #include <memory>
 #include <string>
@@ -13,6 +15,7 @@ class GC_Object;
 class GC_Player;
 class GC_Vehicle;
 class World;
+class WorkerPool;
 
 class AIManager final
 	: private ObjectListener<GC_Player>
@@ -26,11 +29,31 @@ public:
 	typedef std::map<PtrList<GC_Object>::id_type, VehicleState> ControllerStateMap;
 	ControllerStateMap ComputeAIState(World &world, float dt);
 
+	// Time per step for the decisions of idle bots. The cost of a decision measured
+	// so far sets how many decisions the next step takes, so a step is never cut
+	// halfway. At least one decision is taken every step.
+	void SetDecisionBudget(std::chrono::microseconds budget) { _decisionBudget = budget; }
+
+	struct SchedulerStats
+	{
+		unsigned int allowed = 0;   // decisions the budget allowed for the last step
+		unsigned int decisions = 0; // decisions taken during the last step
+		unsigned int deferred = 0;  // idle bots left waiting for a decision
+		std::chrono::microseconds elapsed{}; // time spent on decisions
+	};
+	const SchedulerStats& GetSchedulerStats() const { return _schedulerStats; }
+
 	void GetControllers(std::vector<const AIController*> &controllers) const;
 
 private:
 	std::map<GC_Player *, std::unique_ptr<AIController>> _aiControllers;
 	World &_world;
+	std::unique_ptr<WorkerPool> _workers; // created once there are enough bots
+
+	std::deque<GC_Player *> _decisionQueue; // round-robin order, recently served bots go last
+	std::chrono::microseconds _decisionBudget{ 2000 };
+	float _decisionCost = 0; // average microseconds per decision, 0 until measured
+	SchedulerStats _schedulerStats;
 
 	// ObjectListener<GC_Player>
 	void OnRespawn(GC_Player &obj, GC_Vehicle &vehicle) override;
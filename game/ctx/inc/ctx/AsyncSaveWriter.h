@@ -0,0 +1,36 @@
+#pragma once
+#include <exception>
+#include <functional>
+#include <future>
+#include <list>
+#include <memory>
+#include <vector>
+
+namespace FS
+{
+	struct Stream;
+}
+
+// Writes in-memory snapshots to streams on background threads.
+// Completion callbacks are invoked from Poll() on the thread that owns the writer.
+class AsyncSaveWriter final
+{
+public:
+	typedef std::function<void(std::exception_ptr error)> CompletionCallback;
+
+	AsyncSaveWriter();
+	~AsyncSaveWriter(); // waits for pending writes, their callbacks are dropped
+
+	void Enqueue(std::vector<char> data, std::shared_ptr<FS::Stream> stream, CompletionCallback onComplete);
+	void Poll();
+	void WaitAll();
+	bool IsBusy() const { return !_jobs.empty(); }
+
+private:
+	struct Job
+	{
+		std::shared_future<void> result;
+		CompletionCallback onComplete;
+	};
+	std::list<Job> _jobs;
+};
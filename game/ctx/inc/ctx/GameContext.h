@@ -1,4 +1,5 @@
 #pragma once
+#include "AsyncSaveWriter.h"
 #include "ScriptMessageBroadcaster.h"
 #include "GameContextBase.h"
 #include "GameEvents.h"
@@ -58,6 +59,11 @@ public:
 	void Serialize(FS::Stream &stream);
 	void Deserialize(FS::Stream &stream);
 
+	// Blocks only while the state is copied into memory; the stream is written on a background thread.
+	// onComplete is called from Step once the write has finished or failed.
+	void SerializeAsync(std::shared_ptr<FS::Stream> stream, AsyncSaveWriter::CompletionCallback onComplete);
+	bool IsSaveInProgress() const { return _saveWriter.IsBusy(); }
+
 	// GameContextBase
 	World& GetWorld() override { return *_world; }
 	Gameplay* GetGameplay() const override;
@@ -72,6 +78,7 @@ private:
 	std::unique_ptr<Gameplay> _gameplay;
 	std::unique_ptr<ScriptHarness> _scriptHarness;
 	std::unique_ptr<AIManager> _aiManager;
+	AsyncSaveWriter _saveWriter;
 	const AIDiffuculty _difficulty;
 	float _gameplayTime = 0;
 };
@@ -0,0 +1,34 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of threads that process index ranges together with the calling thread.
+class WorkerPool final
+{
+public:
+	explicit WorkerPool(unsigned int workerCount);
+	~WorkerPool();
+
+	// calls func(i) for every i in [0, count) and returns when all calls are complete
+	void ParallelFor(size_t count, const std::function<void(size_t)> &func);
+
+private:
+	std::vector<std::thread> _threads;
+	std::mutex _mutex;
+	std::condition_variable _wake;
+	std::condition_variable _done;
+
+	const std::function<void(size_t)> *_func = nullptr;
+	size_t _count = 0;
+	std::atomic<size_t> _next{ 0 };
+	unsigned int _busyWorkers = 0;
+	unsigned int _generation = 0;
+	bool _exit = false;
+
+	void WorkerMain();
+	void RunItems();
+};
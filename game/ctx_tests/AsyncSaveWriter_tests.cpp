@@ -0,0 +1,73 @@
+#include <ctx/AsyncSaveWriter.h>
+#include <fs/FileSystem.h>
+#include <gtest/gtest.h>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+	class StringStream final : public FS::Stream
+	{
+	public:
+		std::string data;
+		bool fail = false;
+
+		// FS::Stream
+		size_t Read(void *dst, size_t size, size_t count) override { return 0; }
+		void Write(const void *src, size_t size) override
+		{
+			if (fail)
+				throw std::runtime_error("disk full");
+			data.append(static_cast<const char*>(src), size);
+		}
+		void Seek(long long amount, unsigned int origin) override {}
+		long long Tell() const override { return (long long)data.size(); }
+	};
+
+	std::vector<char> MakeData(const char *str)
+	{
+		return std::vector<char>(str, str + strlen(str));
+	}
+}
+
+TEST(AsyncSaveWriter, WritesAndCompletesInSubmissionOrder)
+{
+	auto stream = std::make_shared<StringStream>();
+	std::vector<int> completed;
+
+	AsyncSaveWriter writer;
+	for (int i = 0; i < 8; i++)
+	{
+		writer.Enqueue(MakeData(std::to_string(i).c_str()), stream, [&completed, i](std::exception_ptr error)
+		{
+			EXPECT_FALSE(error);
+			completed.push_back(i);
+		});
+	}
+	EXPECT_TRUE(writer.IsBusy());
+
+	writer.WaitAll();
+	EXPECT_FALSE(writer.IsBusy());
+	EXPECT_EQ("01234567", stream->data);
+	EXPECT_EQ((std::vector<int>{ 0, 1, 2, 3, 4, 5, 6, 7 }), completed);
+}
+
+TEST(AsyncSaveWriter, ReportsErrorAndKeepsWriting)
+{
+	auto failing = std::make_shared<StringStream>();
+	failing->fail = true;
+	auto stream = std::make_shared<StringStream>();
+	std::exception_ptr errors[2];
+
+	AsyncSaveWriter writer;
+	writer.Enqueue(MakeData("lost"), failing, [&errors](std::exception_ptr error) { errors[0] = error; });
+	writer.Enqueue(MakeData("saved"), stream, [&errors](std::exception_ptr error) { errors[1] = error; });
+	writer.WaitAll();
+
+	ASSERT_TRUE(errors[0]);
+	EXPECT_THROW(std::rethrow_exception(errors[0]), std::runtime_error);
+	EXPECT_FALSE(errors[1]);
+	EXPECT_EQ("saved", stream->data);
+}
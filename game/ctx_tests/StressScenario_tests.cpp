@@ -0,0 +1,287 @@
+#include <ai/ai.h>
+#include <ctx/AIManager.h>
+#include <ctx/WorldController.h>
+#include <gc/Crate.h>
+#include <gc/Macros.h>
+#include <gc/Pickup.h>
+#include <gc/Player.h>
+#include <gc/SpawnPoint.h>
+#include <gc/Turrets.h>
+#include <gc/Wall.h>
+#include <gc/Weapons.h>
+#include <gc/World.h>
+#include <gc/WorldCfg.h>
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+// Scripted battles of many bots. Each scenario runs twice from the same seed
+// and both runs must end in the same world state. The second run allocates the
+// players in the reverse address order so that anything ordered by pointers
+// shows up. The step time is reported as a test property and checked against
+// a budget that TZOD_STRESS_MAX_STEP_MS overrides. The large scenarios are
+// disabled by default; run them with --gtest_also_run_disabled_tests.
+
+namespace
+{
+	constexpr unsigned long SCENARIO_SEED = 2017;
+	constexpr int SCENARIO_STEPS = 600;
+	constexpr float SCENARIO_DT = 1.0f / 60;
+	constexpr float DEFAULT_MAX_STEP_MS = 100;
+
+	struct ScenarioResult
+	{
+		uint32_t hash;
+		std::chrono::microseconds stepTime;
+	};
+
+	class WorldHash final
+	{
+	public:
+		void Add(const void *data, size_t size)
+		{
+			for( size_t i = 0; i < size; i++ )
+				_value = (_value ^ static_cast<const uint8_t*>(data)[i]) * 16777619u;
+		}
+
+		void Add(float value)
+		{
+			uint32_t bits;
+			memcpy(&bits, &value, sizeof(bits));
+			Add(&bits, sizeof(bits));
+		}
+
+		void Add(vec2d value)
+		{
+			Add(value.x);
+			Add(value.y);
+		}
+
+		uint32_t GetValue() const { return _value; }
+
+	private:
+		uint32_t _value = 2166136261u;
+	};
+
+	uint32_t ComputeWorldHash(World &world)
+	{
+		WorldHash hash;
+		hash.Add(world.GetTime());
+		FOREACH( world.GetList(LIST_objects), GC_Object, object )
+		{
+			auto rb = dynamic_cast<GC_RigidBodyStatic*>(object);
+			auto pickup = dynamic_cast<GC_Pickup*>(object);
+			if( !rb && !pickup )
+				continue;
+
+			ObjectType type = object->GetType();
+			hash.Add(&type, sizeof(type));
+			if( rb )
+			{
+				hash.Add(rb->GetPos());
+				hash.Add(rb->GetDirection());
+				hash.Add(rb->GetHealth());
+			}
+			else if( pickup->GetVisible() )
+			{
+				hash.Add(pickup->GetPos());
+			}
+		}
+		return hash.GetValue();
+	}
+
+	vec2d BlockCenter(int x, int y)
+	{
+		return vec2d{ (float)x, (float)y } * WORLD_BLOCK_SIZE + vec2d{ WORLD_BLOCK_SIZE / 2, WORLD_BLOCK_SIZE / 2 };
+	}
+
+	// Fills the world with walls, crates, turrets, weapons and spawn points
+	class MapGenerator final
+	{
+	public:
+		MapGenerator(World &world, unsigned long seed)
+			: _world(world)
+			, _size(WIDTH(world.GetBlockBounds()))
+			, _occupied(_size * _size)
+			, _random(seed)
+		{
+		}
+
+		void Generate(int spawnPointCount)
+		{
+			for( int i = 0; i < _size * _size / 40; i++ )
+			{
+				bool horizontal = Rand(2);
+				int length = 3 + Rand(6);
+				int x = 1 + Rand(_size - 2);
+				int y = 1 + Rand(_size - 2);
+				for( int j = 0; j < length; j++, (horizontal ? x : y)++ )
+				{
+					if( Take(x, y, 1) )
+						_world.New<GC_Wall>(BlockCenter(x, y));
+				}
+			}
+
+			for( int i = 0; i < _size * _size / 400; i++ )
+			{
+				int x = 1 + Rand(_size - 3);
+				int y = 1 + Rand(_size - 3);
+				if( !Take(x, y, 2) )
+					continue;
+				vec2d pos = vec2d{ (float)x + 1, (float)y + 1 } * WORLD_BLOCK_SIZE;
+				switch( i % 3 )
+				{
+				case 0: _world.New<GC_TurretCannon>(pos); break;
+				case 1: _world.New<GC_TurretRocket>(pos); break;
+				case 2: _world.New<GC_TurretMinigun>(pos); break;
+				}
+			}
+
+			for( int i = 0; i < _size * _size / 200; i++ )
+			{
+				int x = 1 + Rand(_size - 2);
+				int y = 1 + Rand(_size - 2);
+				if( Take(x, y, 1) )
+					_world.New<GC_Crate>(BlockCenter(x, y));
+			}
+
+			for( int i = 0; i < _size * _size / 300; i++ )
+			{
+				int x = 1 + Rand(_size - 2);
+				int y = 1 + Rand(_size - 2);
+				if( !Take(x, y, 1) )
+					continue;
+				switch( i % 4 )
+				{
+				case 0: _world.New<GC_Weap_Cannon>(BlockCenter(x, y)); break;
+				case 1: _world.New<GC_Weap_RocketLauncher>(BlockCenter(x, y)); break;
+				case 2: _world.New<GC_Weap_Minigun>(BlockCenter(x, y)); break;
+				case 3: _world.New<GC_Weap_Plazma>(BlockCenter(x, y)); break;
+				}
+			}
+
+			// keep spawn points apart so that vehicles never appear on top of each other
+			for( int placed = 0; placed < spawnPointCount; )
+			{
+				int x = 1 + Rand(_size - 4);
+				int y = 1 + Rand(_size - 4);
+				if( Take(x, y, 3) )
+				{
+					_world.New<GC_SpawnPoint>(BlockCenter(x + 1, y + 1));
+					placed++;
+				}
+			}
+		}
+
+	private:
+		World &_world;
+		int _size;
+		std::vector<bool> _occupied;
+		std::mt19937 _random;
+
+		int Rand(int max)
+		{
+			return static_cast<int>(_random() % static_cast<unsigned int>(max));
+		}
+
+		bool Take(int x, int y, int size)
+		{
+			if( x + size >= _size || y + size >= _size )
+				return false;
+			for( int j = y; j < y + size; j++ )
+				for( int i = x; i < x + size; i++ )
+					if( _occupied[i + j * _size] )
+						return false;
+			for( int j = y; j < y + size; j++ )
+				for( int i = x; i < x + size; i++ )
+					_occupied[i + j * _size] = true;
+			return true;
+		}
+	};
+
+	ScenarioResult RunScenario(int botCount, unsigned long seed, int steps)
+	{
+		int size = 32 + 8 * (int)std::sqrt((float)botCount);
+		World world({ 0, 0, size, size }, true /*initField*/);
+		world.Seed(seed);
+		MapGenerator(world, seed).Generate(botCount);
+
+		AIManager aiManager(world);
+		// a time budget would make the runs depend on the machine load
+		aiManager.SetDecisionBudget(std::chrono::microseconds::max());
+		WorldController worldController(world);
+
+		for( int i = 0; i < botCount; i++ )
+		{
+			auto &player = world.New<GC_Player>();
+			player.SetIsHuman(false);
+			player.SetClass(i % 4 ? "default" : "heavy");
+			player.SetNick(std::string("bot ").append(std::to_string(i)));
+			player.SetTeam(i % 4);
+			aiManager.AssignAI(&player, static_cast<AIDiffuculty>(i % 3));
+		}
+
+		auto startTime = std::chrono::steady_clock::now();
+		for( int i = 0; i < steps; i++ )
+		{
+			worldController.SendControllerStates(aiManager.ComputeAIState(world, SCENARIO_DT));
+			world.Step(SCENARIO_DT);
+		}
+		auto elapsed = std::chrono::steady_clock::now() - startTime;
+
+		return ScenarioResult{
+			ComputeWorldHash(world),
+			std::chrono::duration_cast<std::chrono::microseconds>(elapsed) };
+	}
+
+	void RunStressTest(int botCount)
+	{
+		ScenarioResult first = RunScenario(botCount, SCENARIO_SEED, SCENARIO_STEPS);
+
+		// the object pools hand out the most recently freed memory first, so the
+		// players of the second run are allocated in the reverse address order;
+		// the keeper stops the pool block from being released
+		World keeper({ 0, 0, 8, 8 }, false /*initField*/);
+		keeper.New<GC_Player>();
+		{
+			World ballast({ 0, 0, 8, 8 }, false /*initField*/);
+			for( int i = 0; i < botCount; i++ )
+				ballast.New<GC_Player>();
+		}
+		ScenarioResult second = RunScenario(botCount, SCENARIO_SEED, SCENARIO_STEPS);
+		EXPECT_EQ(first.hash, second.hash) << "simulation is not deterministic";
+
+		float stepMs = (float)(first.stepTime + second.stepTime).count() / 1000.0f / (2 * SCENARIO_STEPS);
+		::testing::Test::RecordProperty("world_hash", std::to_string(first.hash));
+		::testing::Test::RecordProperty("step_time_us", (int)(stepMs * 1000));
+
+		const char *maxStepMs = std::getenv("TZOD_STRESS_MAX_STEP_MS");
+		EXPECT_LE(stepMs, maxStepMs ? (float)std::atof(maxStepMs) : DEFAULT_MAX_STEP_MS) << botCount << " bots";
+	}
+}
+
+TEST(StressScenario, Bots16)
+{
+	RunStressTest(16);
+}
+
+TEST(StressScenario, DISABLED_Bots64)
+{
+	RunStressTest(64);
+}
+
+TEST(StressScenario, DISABLED_Bots128)
+{
+	RunStressTest(128);
+}
+
+TEST(StressScenario, DISABLED_Bots256)
+{
+	RunStressTest(256);
+}
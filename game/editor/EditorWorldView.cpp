@@ -109,6 +109,7 @@ EditorWorldView::EditorWorldView(UI::TimeStepManager &manager,
 	, _objectPreviewWorld(RectRB{ -2, -2, 2, 2 }, false /* initField */)
 	, _world(editorContext->GetWorld())
 	, _worldView(worldView)
+	, _worldViewCache(std::make_unique<WorldViewCache>())
 	, _quickActions(logger, _world)
 {
 	_propList = std::make_shared<PropertyList>(texman, editorContext->GetWorld(), conf, logger, lang);
@@ -574,7 +575,7 @@ void EditorWorldView::Draw(const UI::DataContext &dc, const UI::StateContext &sc
 	options.drawGrid = _conf.drawgrid.Get();
 	options.nightMode = _world.GetNightMode();
 	options.visualizeField = false;
-	_worldView.Render(rc, _world, options);
+	_worldView.Render(rc, _world, options, nullptr, _worldViewCache.get());
 
 	// Selection
 	if( auto selectedObject = PtrDynCast<const GC_MovingObject>(_selectedObject) )
@@ -15,6 +15,7 @@ class TextureManager;
 class EditorConfig;
 class EditorContext;
 class WorldView;
+class WorldViewCache;
 class RenderScheme;
 class GameClassVis;
 
@@ -116,5 +117,6 @@ private:
 
 	World &_world;
 	WorldView &_worldView;
+	std::unique_ptr<WorldViewCache> _worldViewCache;
 	QuickActions _quickActions;
 };
@@ -254,10 +254,10 @@ void GC_ExplosionBig::Init(World &world)
 	SetTimeout(world, 0.10f);
 
 	float duration = 0.72f;
-	world.New<GC_DecalExplosion>(GetPos(), PARTICLE_EXPLOSION2, duration).SetDirection(vrand(1));
+	world.New<GC_DecalExplosion>(GetPos(), PARTICLE_EXPLOSION2, duration).SetDirection(world.net_vrand(1));
 
 	auto &light = world.New<GC_Light>(GetPos(), GC_Light::LIGHT_POINT);
-	light.SetRadius(128 * 5);
+	light.SetRadius(world, 128 * 5);
 	light.SetTimeout(world, duration * 1.5f);
 
 	for( int n = 0; n < 80; ++n )
@@ -265,26 +265,26 @@ void GC_ExplosionBig::Init(World &world)
 		//ring
 		for( int i = 0; i < 2; ++i )
 		{
-			world.New<GC_Particle>(GetPos() + vrand(frand(20.0f)), vrand((200.0f + frand(30.0f)) * 0.9f), PARTICLE_TYPE1, frand(0.6f) + 0.1f);
+			world.New<GC_Particle>(GetPos() + world.net_vrand(world.net_frand(20.0f)), world.net_vrand((200.0f + world.net_frand(30.0f)) * 0.9f), PARTICLE_TYPE1, world.net_frand(0.6f) + 0.1f);
 		}
 
 		vec2d a;
 
 		// dust
-		a = vrand(frand(40.0f));
-		world.New<GC_Particle>(GetPos() + a, a * 2, PARTICLE_TYPE2, frand(0.5f) + 0.25f);
+		a = world.net_vrand(world.net_frand(40.0f));
+		world.New<GC_Particle>(GetPos() + a, a * 2, PARTICLE_TYPE2, world.net_frand(0.5f) + 0.25f);
 
 		// sparkles
-		a = vrand(1);
-		world.New<GC_Particle>(GetPos() + a * frand(40.0f), a * frand(80.0f), PARTICLE_TRACE1, frand(0.3f) + 0.2f).SetDirection(a);
+		a = world.net_vrand(1);
+		world.New<GC_Particle>(GetPos() + a * world.net_frand(40.0f), a * world.net_frand(80.0f), PARTICLE_TRACE1, world.net_frand(0.3f) + 0.2f).SetDirection(a);
 
 		// smoke
-		a = vrand(frand(48.0f));
-		world.New<GC_Particle>(GetPos() + a, SPEED_SMOKE + a * 0.5f, PARTICLE_SMOKE, 1.5f, frand(1.0f));
+		a = world.net_vrand(world.net_frand(48.0f));
+		world.New<GC_Particle>(GetPos() + a, SPEED_SMOKE + a * 0.5f, PARTICLE_SMOKE, 1.5f, world.net_frand(1.0f));
 	}
 
 	auto &p = world.New<GC_Decal>(GetPos(), PARTICLE_BIGBLAST, 20.0f);
-	p.SetDirection(vrand(1));
+	p.SetDirection(world.net_vrand(1));
 	p.SetFade(true);
 }
 
@@ -314,25 +314,25 @@ void GC_ExplosionStandard::Init(World &world)
 	SetTimeout(world, 0.03f);
 
 	float duration = 0.32f;
-	world.New<GC_DecalExplosion>(GetPos(), PARTICLE_EXPLOSION1, duration).SetDirection(vrand(1));
+	world.New<GC_DecalExplosion>(GetPos(), PARTICLE_EXPLOSION1, duration).SetDirection(world.net_vrand(1));
 
 	auto &light = world.New<GC_Light>(GetPos(), GC_Light::LIGHT_POINT);
-	light.SetRadius(70 * 5);
+	light.SetRadius(world, 70 * 5);
 	light.SetTimeout(world, duration * 1.5f);
 
 	for(int n = 0; n < 28; ++n)
 	{
 		// ring
-		float ang = frand(PI2);
-		world.New<GC_Particle>(GetPos(), Vec2dDirection(ang) * 100, PARTICLE_TYPE1, frand(0.5f) + 0.1f);
+		float ang = world.net_frand(PI2);
+		world.New<GC_Particle>(GetPos(), Vec2dDirection(ang) * 100, PARTICLE_TYPE1, world.net_frand(0.5f) + 0.1f);
 
 		// smoke
-		ang = frand(PI2);
-		float d = frand(64.0f) - 32.0f;
+		ang = world.net_frand(PI2);
+		float d = world.net_frand(64.0f) - 32.0f;
 
-		world.New<GC_Particle>(GetPos() + Vec2dDirection(ang) * d, SPEED_SMOKE, PARTICLE_SMOKE, 1.5f, frand(1.0f));
+		world.New<GC_Particle>(GetPos() + Vec2dDirection(ang) * d, SPEED_SMOKE, PARTICLE_SMOKE, 1.5f, world.net_frand(1.0f));
 	}
 	auto &p = world.New<GC_Decal>(GetPos(), PARTICLE_SMALLBLAST, 8.0f);
-	p.SetDirection(vrand(1));
+	p.SetDirection(world.net_vrand(1));
 	p.SetFade(true);
 }
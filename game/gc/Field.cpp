@@ -1,19 +1,51 @@
 #include "inc/gc/Field.h"
+#include "inc/gc/FieldClusters.h"
+#include "inc/gc/FlowFieldCache.h"
+#include "inc/gc/Macros.h"
 #include "inc/gc/RigidBody.h"
 #include "inc/gc/World.h"
 #include "inc/gc/WorldCfg.h"
 #include <cassert>
+#include <vector>
 
-unsigned int FieldCell::_sessionId;
+static uint8_t GetObstacleFlags(const World& world, ObjectList::id_type object)
+{
+	auto rigidStatic = static_cast<GC_RigidBodyStatic*>(world.GetList(GlobalListID::LIST_objects).at(object));
+	assert(rigidStatic->GetObstacleFlags());
+	return rigidStatic->GetObstacleFlags();
+}
 
-void FieldCell::UpdateProperties(const World& world)
+void FieldCell::UpdateProperties()
 {
 	_obstacleFlags = 0;
-	for( unsigned int i = 0; i < GetObjectsCount(); i++ )
+	for( unsigned int bit = 0; bit < 8; bit++ )
+	{
+		if( _obstacleRefs[bit] )
+			_obstacleFlags |= 1 << bit;
+	}
+}
+
+void FieldCell::AddObstacleRefs(uint8_t obstacleFlags)
+{
+	for( unsigned int bit = 0; bit < 8; bit++ )
+	{
+		if( obstacleFlags & (1 << bit) )
+		{
+			assert(_obstacleRefs[bit] < 0xFFFF);
+			_obstacleRefs[bit]++;
+		}
+	}
+}
+
+void FieldCell::RemoveObstacleRefs(uint8_t obstacleFlags)
+{
+	for( unsigned int bit = 0; bit < 8; bit++ )
 	{
-		auto object = static_cast<GC_RigidBodyStatic*>(world.GetList(GlobalListID::LIST_objects).at(GetObject(i)));
-		assert(object->GetObstacleFlags());
-		_obstacleFlags |= object->GetObstacleFlags();
+		if( obstacleFlags & (1 << bit) )
+		{
+			assert(_obstacleRefs[bit] > 0);
+			_obstacleRefs[bit]--;
+		}
 	}
 }
 
@@ -26,69 +58,69 @@ void FieldCell::AddObject(const World& world, ObjectList::id_type object)
 	}
 #endif
 
-	if (_objCount > 0)
+	if( _objCount < INLINE_CAPACITY )
 	{
-		std::unique_ptr<ObjectList::id_type[]> tmp(new ObjectList::id_type[_objCount + 1]);
-		if (_objCount == 1)
-		{
-			tmp[0] = _storage._singleObject;
-		}
-		else
-		{
-			std::memcpy(tmp.get(), _storage._objects, _objCount * sizeof(ObjectList::id_type));
-			delete[] _storage._objects;
-		}
-		tmp[_objCount] = object;
-		_storage._objects = tmp.release();
+		_inlineObjects[_objCount] = object;
 	}
 	else
 	{
-		_storage._singleObject = object;
+		if( !_overflowObjects )
+			_overflowObjects = std::make_unique<std::vector<ObjectList::id_type>>();
+		_overflowObjects->push_back(object);
 	}
-
 	_objCount++;
 
-	UpdateProperties(world);
+	AddObstacleRefs(GetObstacleFlags(world, object));
+	UpdateProperties();
 }
 
 void FieldCell::RemoveObject(const World& world, ObjectList::id_type object)
 {
 	assert(_objCount > 0);
 
-	if( 1 == _objCount )
+	// keep the order of the remaining objects
+	unsigned int index = 0;
+	while( GetObject(index) != object )
 	{
-		assert(object == _storage._singleObject);
-		_storage._singleObject = ObjectList::id_type();
+		index++;
+		assert(index < _objCount);
 	}
-	else if (2 == _objCount)
+	for( ; index + 1 < std::min(_objCount, INLINE_CAPACITY); index++ )
 	{
-		ObjectList::id_type tmp = _storage._objects[0] == object ? _storage._objects[1] : _storage._objects[0];
-		delete[] _storage._objects;
-		_storage._singleObject = tmp;
+		_inlineObjects[index] = _inlineObjects[index + 1];
 	}
-	else
+	if( _objCount > INLINE_CAPACITY )
 	{
-		auto tmp = std::make_unique<ObjectList::id_type[]>(_objCount - 1);
-		int j = 0;
-		for( unsigned int i = 0; i < _objCount; ++i )
+		if( index < INLINE_CAPACITY )
 		{
-			if( object != _storage._objects[i] )
-				tmp[j++] = _storage._objects[i];
+			_inlineObjects[INLINE_CAPACITY - 1] = _overflowObjects->front();
+			index = INLINE_CAPACITY;
 		}
-		assert(j == _objCount - 1);
-		delete[] _storage._objects;
-		_storage._objects = tmp.release();
+		_overflowObjects->erase(_overflowObjects->begin() + (index - INLINE_CAPACITY));
 	}
 	_objCount--;
-	UpdateProperties(world);
+
+	RemoveObstacleRefs(GetObstacleFlags(world, object));
+	UpdateProperties();
 }
 
 ////////////////////////////////////////////////////////////
 
+Field::Field()
+{
+}
+
+Field::~Field()
+{
+}
+
 void Field::Resize(int width, int height)
 {
 	assert(width > 0 && height > 0);
 	_cells = std::make_unique<FieldCell[]>(width * height);
+	_parents = std::make_unique<RefFieldCell[]>(width * height);
+	_clusters = std::make_unique<FieldClusters>(width, height);
+	_flowFields = std::make_unique<FlowFieldCache>(width, height);
 	_width = width;
 	_height = height;
 	for( int y = 0; y < height; y++ )
@@ -99,26 +131,57 @@ void Field::Resize(int width, int height)
 				(*this)(x, y)._obstacleFlags = 0xFF;
 		}
 	}
-	FieldCell::_sessionId = 0;
+	_sessionId = 0;
 }
 
-void Field::ProcessObject(const World& world, GC_RigidBodyStatic *object, bool add)
+void Field::InvalidateCells(int left, int top, int right, int bottom)
+{
+	_clusters->Invalidate(left, top, right, bottom);
+	_flowFields->Invalidate(left, top, right, bottom);
+}
+
+RectRB Field::GetObjectCells(const World& world, vec2d pos, float radius)
 {
 	RectRB blockBounds = world.GetBlockBounds();
-	float r = object->GetRadius() / WORLD_BLOCK_SIZE;
-	vec2d p = object->GetPos() / WORLD_BLOCK_SIZE;
+	float r = radius / WORLD_BLOCK_SIZE;
+	vec2d p = pos / WORLD_BLOCK_SIZE;
 
-	assert(WIDTH(blockBounds) + 1 == _width && HEIGHT(blockBounds) + 1 == _height);
 	assert(r >= 0);
 
-	int xmin = std::min(blockBounds.right, std::max(blockBounds.left, (int)std::floor(p.x - r + 0.5f)));
-	int xmax = std::min(blockBounds.right, std::max(blockBounds.left, (int)std::floor(p.x + r + 0.5f)));
-	int ymin = std::min(blockBounds.bottom, std::max(blockBounds.top, (int)std::floor(p.y - r + 0.5f)));
-	int ymax = std::min(blockBounds.bottom, std::max(blockBounds.top, (int)std::floor(p.y + r + 0.5f)));
+	// inclusive range in blocks
+	RectRB cells;
+	cells.left = std::min(blockBounds.right, std::max(blockBounds.left, (int)std::floor(p.x - r + 0.5f)));
+	cells.right = std::min(blockBounds.right, std::max(blockBounds.left, (int)std::floor(p.x + r + 0.5f)));
+	cells.top = std::min(blockBounds.bottom, std::max(blockBounds.top, (int)std::floor(p.y - r + 0.5f)));
+	cells.bottom = std::min(blockBounds.bottom, std::max(blockBounds.top, (int)std::floor(p.y + r + 0.5f)));
+	return cells;
+}
 
-	for (int x = xmin; x <= xmax; x++)
+void Field::ProcessObject(const World& world, GC_RigidBodyStatic *object, bool add)
+{
+	ProcessCells(world, object, GetObjectCells(world, object->GetPos(), object->GetRadius()), add);
+}
+
+void Field::MoveObject(const World& world, GC_RigidBodyStatic *object, vec2d oldPos)
+{
+	RectRB oldCells = GetObjectCells(world, oldPos, object->GetRadius());
+	RectRB newCells = GetObjectCells(world, object->GetPos(), object->GetRadius());
+	if (oldCells.left != newCells.left || oldCells.top != newCells.top ||
+		oldCells.right != newCells.right || oldCells.bottom != newCells.bottom)
 	{
-		for (int y = ymin; y <= ymax; y++)
+		ProcessCells(world, object, oldCells, false);
+		ProcessCells(world, object, newCells, true);
+	}
+}
+
+void Field::ProcessCells(const World& world, GC_RigidBodyStatic *object, RectRB cells, bool add)
+{
+	RectRB blockBounds = world.GetBlockBounds();
+	assert(WIDTH(blockBounds) + 1 == _width && HEIGHT(blockBounds) + 1 == _height);
+
+	for (int x = cells.left; x <= cells.right; x++)
+	{
+		for (int y = cells.top; y <= cells.bottom; y++)
 		{
 			if (add)
 			{
@@ -132,4 +195,48 @@ void Field::ProcessObject(const World& world, GC_RigidBodyStatic *object, bool a
 			}
 		}
 	}
+
+	InvalidateCells(cells.left - blockBounds.left, cells.top - blockBounds.top,
+		cells.right - blockBounds.left, cells.bottom - blockBounds.top);
+}
+
+void Field::Build(const World& world)
+{
+	RectRB blockBounds = world.GetBlockBounds();
+	assert(WIDTH(blockBounds) + 1 == _width && HEIGHT(blockBounds) + 1 == _height);
+
+	std::vector<RefFieldCell> passableBorderCells;
+
+	// same order the objects would be added in one by one
+	FOREACH(world.GetList(LIST_objects), GC_Object, object)
+	{
+		auto rigidStatic = dynamic_cast<const GC_RigidBodyStatic*>(object);
+		if (!rigidStatic || !rigidStatic->GetObstacleFlags())
+			continue;
+
+		int passableX, passableY;
+		bool hasPassableCell = rigidStatic->GetPassableFieldCell(world, passableX, passableY);
+
+		RectRB cells = GetObjectCells(world, rigidStatic->GetPos(), rigidStatic->GetRadius());
+		for (int x = cells.left; x <= cells.right; x++)
+		{
+			for (int y = cells.top; y <= cells.bottom; y++)
+			{
+				if (!hasPassableCell || x != passableX || y != passableY)
+					(*this)(x - blockBounds.left, y - blockBounds.top).AddObject(world, rigidStatic->GetId());
+			}
+		}
+
+		if (hasPassableCell &&
+			(blockBounds.left == passableX || blockBounds.top == passableY || blockBounds.right == passableX || blockBounds.bottom == passableY))
+		{
+			passableBorderCells.push_back({ passableX - blockBounds.left, passableY - blockBounds.top });
+		}
+	}
+
+	// border cells stay blocked
+	for (auto ref: passableBorderCells)
+		(*this)(ref.x, ref.y)._obstacleFlags = 0xFF;
+
+	InvalidateCells(0, 0, _width - 1, _height - 1);
 }
@@ -0,0 +1,391 @@
+#include "inc/gc/FieldClusters.h"
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <queue>
+
+static constexpr int CLUSTER_CELLS = FieldClusters::CLUSTER_SIZE * FieldClusters::CLUSTER_SIZE;
+
+// cluster side offsets: right, bottom, left, top
+static constexpr int side_x[4] = { 1, 0,-1, 0 };
+static constexpr int side_y[4] = { 0, 1, 0,-1 };
+
+// upper bound of Euclidean distance
+static int EstimatePathLength(RefFieldCell begin, RefFieldCell end)
+{
+	int dx = std::abs(end.x - begin.x);
+	int dy = std::abs(end.y - begin.y);
+	return std::max(dx, dy) * Field::STEP_COST + std::min(dx, dy) * (Field::STEP_COST_DIAG - Field::STEP_COST);
+}
+
+static int GetLocalIndex(const RectRB &rect, RefFieldCell cell)
+{
+	assert(cell.x >= rect.left && cell.x <= rect.right && cell.y >= rect.top && cell.y <= rect.bottom);
+	return (cell.x - rect.left) + (cell.y - rect.top) * FieldClusters::CLUSTER_SIZE;
+}
+
+FieldClusters::FieldClusters(int fieldWidth, int fieldHeight)
+	: _fieldWidth(fieldWidth)
+	, _fieldHeight(fieldHeight)
+	, _width((fieldWidth + CLUSTER_SIZE - 1) / CLUSTER_SIZE)
+	, _height((fieldHeight + CLUSTER_SIZE - 1) / CLUSTER_SIZE)
+	, _revisions(_width * _height)
+{
+}
+
+FieldClusters::~FieldClusters()
+{
+}
+
+void FieldClusters::Invalidate(int left, int top, int right, int bottom)
+{
+	int clusterLeft = std::max(0, left / CLUSTER_SIZE);
+	int clusterTop = std::max(0, top / CLUSTER_SIZE);
+	int clusterRight = std::min(_width - 1, right / CLUSTER_SIZE);
+	int clusterBottom = std::min(_height - 1, bottom / CLUSTER_SIZE);
+	for( int cy = clusterTop; cy <= clusterBottom; cy++ )
+	{
+		for( int cx = clusterLeft; cx <= clusterRight; cx++ )
+		{
+			_revisions[cx + cy * _width]++;
+		}
+	}
+	_totalRevision++;
+}
+
+RectRB FieldClusters::GetClusterCells(RefFieldCell cell) const
+{
+	return GetClusterRect(GetClusterIndex(cell));
+}
+
+int FieldClusters::GetClusterDistance(RefFieldCell a, RefFieldCell b)
+{
+	return std::max(std::abs(a.x / CLUSTER_SIZE - b.x / CLUSTER_SIZE), std::abs(a.y / CLUSTER_SIZE - b.y / CLUSTER_SIZE));
+}
+
+RectRB FieldClusters::GetClusterRect(int clusterIndex) const
+{
+	int cx = clusterIndex % _width;
+	int cy = clusterIndex / _width;
+	return RectRB{
+		cx * CLUSTER_SIZE,
+		cy * CLUSTER_SIZE,
+		std::min(_fieldWidth, (cx + 1) * CLUSTER_SIZE) - 1,
+		std::min(_fieldHeight, (cy + 1) * CLUSTER_SIZE) - 1 };
+}
+
+int FieldClusters::GetClusterIndex(RefFieldCell cell) const
+{
+	assert(cell.x >= 0 && cell.x < _fieldWidth && cell.y >= 0 && cell.y < _fieldHeight);
+	return cell.x / CLUSTER_SIZE + cell.y / CLUSTER_SIZE * _width;
+}
+
+int FieldClusters::GetStepCost(const Field &field, const Layer &layer, RefFieldCell to, int dx, int dy) const
+{
+	uint8_t obstacleFlags = field(to.x, to.y).ObstacleFlags();
+	if( obstacleFlags & layer.passabilityMask )
+		return 0;
+	return (dx && dy ? Field::STEP_COST_DIAG : Field::STEP_COST) * (obstacleFlags ? layer.distanceMultiplier : 1);
+}
+
+FieldClusters::Layer& FieldClusters::GetLayer(uint8_t passabilityMask, int distanceMultiplier)
+{
+	for( auto &layer: _layers )
+	{
+		if( layer->passabilityMask == passabilityMask && layer->distanceMultiplier == distanceMultiplier )
+			return *layer;
+	}
+	_layers.push_back(std::make_unique<Layer>());
+	Layer &layer = *_layers.back();
+	layer.passabilityMask = passabilityMask;
+	layer.distanceMultiplier = distanceMultiplier;
+	layer.clusters.resize(_width * _height);
+	return layer;
+}
+
+void FieldClusters::Repair(const Field &field, Layer &layer)
+{
+	if( layer.revision == _totalRevision )
+		return;
+
+	// entrances of a changed cluster are shared with its neighbors
+	std::vector<bool> rebuild(layer.clusters.size());
+	for( int cy = 0; cy < _height; cy++ )
+	{
+		for( int cx = 0; cx < _width; cx++ )
+		{
+			int index = cx + cy * _width;
+			if( layer.clusters[index].revision != _revisions[index] )
+			{
+				rebuild[index] = true;
+				for( int side = 0; side < 4; side++ )
+				{
+					int nx = cx + side_x[side];
+					int ny = cy + side_y[side];
+					if( nx >= 0 && nx < _width && ny >= 0 && ny < _height )
+						rebuild[nx + ny * _width] = true;
+				}
+			}
+		}
+	}
+
+	for( int index = 0; index < (int)layer.clusters.size(); index++ )
+	{
+		if( rebuild[index] )
+		{
+			Cluster &cluster = layer.clusters[index];
+			BuildNodes(field, layer, index, cluster);
+			BuildEdges(field, layer, index, cluster);
+			cluster.revision = _revisions[index];
+		}
+	}
+
+	layer.revision = _totalRevision;
+}
+
+void FieldClusters::BuildNodes(const Field &field, const Layer &layer, int clusterIndex, Cluster &cluster) const
+{
+	RectRB rect = GetClusterRect(clusterIndex);
+	cluster.nodes.clear();
+
+	for( int side = 0; side < 4; side++ )
+	{
+		cluster.sideBegin[side] = (uint16_t) cluster.nodes.size();
+
+		// inner border cells of the side
+		RefFieldCell first = { side == 0 ? rect.right : rect.left, side == 1 ? rect.bottom : rect.top };
+		int length = side & 1 ? WIDTH(rect) + 1 : HEIGHT(rect) + 1;
+		int stepX = side & 1;
+		int stepY = 1 - stepX;
+
+		int outerX = first.x + side_x[side];
+		int outerY = first.y + side_y[side];
+		if( outerX < 0 || outerX >= _fieldWidth || outerY < 0 || outerY >= _fieldHeight )
+			continue; // no neighbor on this side
+
+		// each run of passable cell pairs makes an entrance in its middle
+		int runStart = -1;
+		for( int i = 0; i <= length; i++ )
+		{
+			bool passable = false;
+			if( i < length )
+			{
+				RefFieldCell inner = { first.x + stepX * i, first.y + stepY * i };
+				RefFieldCell outer = { inner.x + side_x[side], inner.y + side_y[side] };
+				passable = GetStepCost(field, layer, inner, side_x[side], side_y[side]) &&
+					GetStepCost(field, layer, outer, side_x[side], side_y[side]);
+			}
+			if( passable && runStart < 0 )
+			{
+				runStart = i;
+			}
+			else if( !passable && runStart >= 0 )
+			{
+				int middle = (runStart + i - 1) / 2;
+				Node node;
+				node.cellRef = { first.x + stepX * middle, first.y + stepY * middle };
+				node.side = (uint8_t) side;
+				node.entrance = (uint16_t) (cluster.nodes.size() - cluster.sideBegin[side]);
+				cluster.nodes.push_back(std::move(node));
+				runStart = -1;
+			}
+		}
+	}
+
+	cluster.sideBegin[4] = (uint16_t) cluster.nodes.size();
+}
+
+void FieldClusters::BuildEdges(const Field &field, const Layer &layer, int clusterIndex, Cluster &cluster) const
+{
+	RectRB rect = GetClusterRect(clusterIndex);
+	int costs[CLUSTER_CELLS];
+	for( auto &node: cluster.nodes )
+	{
+		ComputeLocalCosts(field, layer, clusterIndex, node.cellRef, false, costs);
+		for( uint16_t other = 0; other < cluster.nodes.size(); other++ )
+		{
+			int cost = costs[GetLocalIndex(rect, cluster.nodes[other].cellRef)];
+			if( &cluster.nodes[other] != &node && cost >= 0 )
+				node.edges.push_back({ other, cost });
+		}
+	}
+}
+
+void FieldClusters::ComputeLocalCosts(const Field &field, const Layer &layer, int clusterIndex, RefFieldCell origin, bool reverse, int *costs) const
+{
+	RectRB rect = GetClusterRect(clusterIndex);
+	std::fill(costs, costs + CLUSTER_CELLS, -1);
+
+	struct OpenListNode
+	{
+		RefFieldCell cellRef;
+		int before;
+
+		bool operator<(OpenListNode other) const
+		{
+			return before > other.before;
+		}
+	};
+	std::priority_queue<OpenListNode> open;
+
+	costs[GetLocalIndex(rect, origin)] = 0;
+	open.push({ origin, 0 });
+	while( !open.empty() )
+	{
+		OpenListNode current = open.top();
+		open.pop();
+		if( current.before > costs[GetLocalIndex(rect, current.cellRef)] )
+			continue; // outdated entry
+
+		for( int dy = -1; dy <= 1; dy++ )
+		{
+			for( int dx = -1; dx <= 1; dx++ )
+			{
+				RefFieldCell nextRef = { current.cellRef.x + dx, current.cellRef.y + dy };
+				if( (!dx && !dy) || nextRef.x < rect.left || nextRef.x > rect.right || nextRef.y < rect.top || nextRef.y > rect.bottom )
+					continue;
+
+				// the reverse search finds costs of getting to the origin
+				int stepCost = GetStepCost(field, layer, nextRef, dx, dy);
+				if( reverse && stepCost )
+					stepCost = GetStepCost(field, layer, current.cellRef, dx, dy);
+
+				int &nextCost = costs[GetLocalIndex(rect, nextRef)];
+				if( stepCost && (nextCost < 0 || current.before + stepCost < nextCost) )
+				{
+					nextCost = current.before + stepCost;
+					open.push({ nextRef, nextCost });
+				}
+			}
+		}
+	}
+}
+
+bool FieldClusters::FindAbstractPath(const Field &field, RefFieldCell start, RefFieldCell end,
+	uint8_t passabilityMask, int distanceMultiplier, int maxCost, std::vector<RefFieldCell> &waypoints)
+{
+	Layer &layer = GetLayer(passabilityMask, distanceMultiplier);
+	Repair(field, layer);
+
+	waypoints.clear();
+	if( !GetStepCost(field, layer, start, 0, 0) || !GetStepCost(field, layer, end, 0, 0) )
+		return false;
+
+	int startCluster = GetClusterIndex(start);
+	int endCluster = GetClusterIndex(end);
+	RectRB startRect = GetClusterRect(startCluster);
+	RectRB endRect = GetClusterRect(endCluster);
+
+	int startCosts[CLUSTER_CELLS];
+	int endCosts[CLUSTER_CELLS];
+	ComputeLocalCosts(field, layer, startCluster, start, false, startCosts);
+	ComputeLocalCosts(field, layer, endCluster, end, true, endCosts);
+
+	if( startCluster == endCluster && startCosts[GetLocalIndex(startRect, end)] >= 0 )
+	{
+		waypoints.push_back(start);
+		waypoints.push_back(end);
+		return startCosts[GetLocalIndex(startRect, end)] < maxCost;
+	}
+
+	struct OpenListNode
+	{
+		int cluster;
+		int node; // -1 marks the end
+		int before;
+		int totalEstimate;
+
+		bool operator<(OpenListNode other) const
+		{
+			return totalEstimate > other.totalEstimate;
+		}
+	};
+	std::priority_queue<OpenListNode> open;
+
+	++_session;
+	int bestTotal = maxCost;
+	int bestCluster = -1;
+	uint16_t bestNode = 0;
+
+	auto relax = [&](int clusterIndex, uint16_t nodeIndex, int before, int prevCluster, uint16_t prevNode)
+	{
+		Node &node = layer.clusters[clusterIndex].nodes[nodeIndex];
+		if( node.session != _session || before < node.before )
+		{
+			node.session = _session;
+			node.before = before;
+			node.prevCluster = prevCluster;
+			node.prevNode = prevNode;
+
+			int totalEstimate = before + EstimatePathLength(node.cellRef, end);
+			if( totalEstimate < bestTotal )
+				open.push({ clusterIndex, nodeIndex, before, totalEstimate });
+		}
+	};
+
+	const Cluster &first = layer.clusters[startCluster];
+	for( uint16_t i = 0; i < first.nodes.size(); i++ )
+	{
+		int cost = startCosts[GetLocalIndex(startRect, first.nodes[i].cellRef)];
+		if( cost >= 0 )
+			relax(startCluster, i, cost, -1, 0);
+	}
+
+	while( !open.empty() )
+	{
+		OpenListNode currentNode = open.top();
+		open.pop();
+		if( currentNode.node < 0 )
+			break; // the best path to the end can not be improved anymore
+
+		const Cluster &cluster = layer.clusters[currentNode.cluster];
+		const Node &current = cluster.nodes[currentNode.node];
+		if( current.session != _session || currentNode.before > current.before )
+			continue; // outdated entry
+
+		if( currentNode.cluster == endCluster )
+		{
+			int cost = endCosts[GetLocalIndex(endRect, current.cellRef)];
+			if( cost >= 0 && current.before + cost < bestTotal )
+			{
+				bestTotal = current.before + cost;
+				bestCluster = currentNode.cluster;
+				bestNode = (uint16_t) currentNode.node;
+				open.push({ -1, -1, bestTotal, bestTotal });
+			}
+		}
+
+		for( const Edge &edge: current.edges )
+		{
+			relax(currentNode.cluster, edge.node, current.before + edge.cost, currentNode.cluster, (uint16_t) currentNode.node);
+		}
+
+		// step over the border to the paired entrance of the neighbor cluster
+		int neighbor = currentNode.cluster + side_x[current.side] + side_y[current.side] * _width;
+		const Cluster &other = layer.clusters[neighbor];
+		uint16_t pairedNode = other.sideBegin[current.side ^ 2] + current.entrance;
+		assert(pairedNode < other.sideBegin[(current.side ^ 2) + 1]);
+		int stepCost = GetStepCost(field, layer, other.nodes[pairedNode].cellRef, side_x[current.side], side_y[current.side]);
+		assert(stepCost);
+		relax(neighbor, pairedNode, current.before + stepCost, currentNode.cluster, (uint16_t) currentNode.node);
+	}
+
+	if( bestCluster < 0 )
+		return false;
+
+	// trace back
+	waypoints.push_back(end);
+	for( int clusterIndex = bestCluster; clusterIndex >= 0; )
+	{
+		const Node &node = layer.clusters[clusterIndex].nodes[bestNode];
+		if( waypoints.back() != node.cellRef )
+			waypoints.push_back(node.cellRef);
+		clusterIndex = node.prevCluster;
+		bestNode = node.prevNode;
+	}
+	if( waypoints.back() != start )
+		waypoints.push_back(start);
+	std::reverse(waypoints.begin(), waypoints.end());
+
+	return true;
+}
@@ -0,0 +1,159 @@
+#include "inc/gc/FlowFieldCache.h"
+#include <algorithm>
+#include <cassert>
+#include <climits>
+#include <queue>
+
+int FlowField::GetStepCost(const Field &field, RefFieldCell to, int dx, int dy) const
+{
+	uint8_t obstacleFlags = field(to.x, to.y).ObstacleFlags();
+	if( obstacleFlags & _passabilityMask )
+		return 0;
+	return (dx && dy ? Field::STEP_COST_DIAG : Field::STEP_COST) * (obstacleFlags ? _distanceMultiplier : 1);
+}
+
+void FlowField::Compute(const Field &field, int fieldHeight)
+{
+	_costs.assign(_width * fieldHeight, -1);
+	_reached = { _goal.x, _goal.y, _goal.x, _goal.y };
+	if( !GetStepCost(field, _goal, 0, 0) )
+		return;
+
+	struct OpenListNode
+	{
+		RefFieldCell cellRef;
+		int before;
+
+		bool operator<(OpenListNode other) const
+		{
+			return before > other.before;
+		}
+	};
+	std::priority_queue<OpenListNode> open;
+
+	// reverse Dijkstra: the cost of a step is defined by the cell being entered
+	_costs[_goal.x + _goal.y * _width] = 0;
+	open.push({ _goal, 0 });
+	while( !open.empty() )
+	{
+		OpenListNode current = open.top();
+		open.pop();
+		if( current.before > GetCost(current.cellRef) )
+			continue; // outdated entry
+
+		_reached.left = std::min(_reached.left, current.cellRef.x);
+		_reached.top = std::min(_reached.top, current.cellRef.y);
+		_reached.right = std::max(_reached.right, current.cellRef.x);
+		_reached.bottom = std::max(_reached.bottom, current.cellRef.y);
+
+		for( int dy = -1; dy <= 1; dy++ )
+		{
+			for( int dx = -1; dx <= 1; dx++ )
+			{
+				if( !dx && !dy )
+					continue;
+
+				// border cells are never passable so the neighbors always exist
+				RefFieldCell prevRef = { current.cellRef.x + dx, current.cellRef.y + dy };
+				if( !GetStepCost(field, prevRef, dx, dy) )
+					continue;
+
+				int prevCost = current.before + GetStepCost(field, current.cellRef, dx, dy);
+				int &cost = _costs[prevRef.x + prevRef.y * _width];
+				if( prevCost < _maxCost && (cost < 0 || prevCost < cost) )
+				{
+					cost = prevCost;
+					open.push({ prevRef, prevCost });
+				}
+			}
+		}
+	}
+}
+
+bool FlowField::Trace(const Field &field, RefFieldCell start, std::vector<RefFieldCell> &cells) const
+{
+	int cost = GetCost(start);
+	if( cost < 0 )
+		return false;
+
+	for( RefFieldCell current = start; current != _goal; )
+	{
+		// the neighbor the cost of current cell was derived from
+		RefFieldCell best = current;
+		int bestTotal = INT_MAX;
+		for( int dy = -1; dy <= 1; dy++ )
+		{
+			for( int dx = -1; dx <= 1; dx++ )
+			{
+				RefFieldCell nextRef = { current.x + dx, current.y + dy };
+				int nextCost = (dx || dy) ? GetCost(nextRef) : -1;
+				if( nextCost >= 0 && nextCost < cost )
+				{
+					int total = nextCost + GetStepCost(field, nextRef, dx, dy);
+					if( total < bestTotal )
+					{
+						best = nextRef;
+						bestTotal = total;
+					}
+				}
+			}
+		}
+		assert(best != current);
+		cells.push_back(best);
+		current = best;
+		cost = GetCost(current);
+	}
+
+	return true;
+}
+
+////////////////////////////////////////////////////////////
+
+FlowFieldCache::FlowFieldCache(int fieldWidth, int fieldHeight)
+	: _fieldWidth(fieldWidth)
+	, _fieldHeight(fieldHeight)
+{
+}
+
+void FlowFieldCache::Invalidate(int left, int top, int right, int bottom)
+{
+	for( auto &flow: _entries )
+	{
+		// a cell next to the reached area may open a shorter way in
+		if( !flow._costs.empty() &&
+			left <= flow._reached.right + 1 && right >= flow._reached.left - 1 &&
+			top <= flow._reached.bottom + 1 && bottom >= flow._reached.top - 1 )
+		{
+			flow._costs.clear();
+		}
+	}
+}
+
+const FlowField* FlowFieldCache::Get(const Field &field, RefFieldCell goal, uint8_t passabilityMask, int distanceMultiplier, int maxCost)
+{
+	auto it = std::find_if(_entries.begin(), _entries.end(), [&](const FlowField &flow)
+	{
+		return flow._goal == goal && flow._passabilityMask == passabilityMask &&
+			flow._distanceMultiplier == distanceMultiplier && flow._maxCost == maxCost;
+	});
+
+	if( _entries.end() == it )
+	{
+		if( _entries.size() >= CAPACITY )
+			_entries.pop_back();
+		_entries.emplace_front();
+		FlowField &flow = _entries.front();
+		flow._goal = goal;
+		flow._passabilityMask = passabilityMask;
+		flow._distanceMultiplier = distanceMultiplier;
+		flow._maxCost = maxCost;
+		flow._width = _fieldWidth;
+		return nullptr;
+	}
+
+	_entries.splice(_entries.begin(), _entries, it);
+	FlowField &flow = _entries.front();
+	if( flow._costs.empty() )
+		flow.Compute(field, _fieldHeight);
+	return &flow;
+}
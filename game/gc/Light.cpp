@@ -5,6 +5,7 @@
 #include "inc/gc/WorldCfg.h"
 #include "inc/gc/SaveFile.h"
 #include <MapFile.h>
+#include <algorithm>
 #include <cfloat>
 
 IMPLEMENT_SELF_REGISTRATION(GC_Light)
@@ -13,6 +14,7 @@ IMPLEMENT_SELF_REGISTRATION(GC_Light)
 }
 
 IMPLEMENT_1LIST_MEMBER(GC_MovingObject, GC_Light, LIST_lights);
+IMPLEMENT_GRID_MEMBER(GC_MovingObject, GC_Light, grid_lights);
 
 GC_Light::GC_Light(vec2d pos, enumLightType type)
 	: GC_MovingObject(pos)
@@ -37,6 +39,18 @@ GC_Light::~GC_Light()
 {
 }
 
+void GC_Light::Init(World &world)
+{
+	GC_MovingObject::Init(world);
+	AddRenderRadius(world);
+}
+
+void GC_Light::Kill(World &world)
+{
+	RemoveRenderRadius(world);
+	GC_MovingObject::Kill(world);
+}
+
 void GC_Light::Serialize(World &world, SaveFile &f)
 {
 	GC_MovingObject::Serialize(world, f);
@@ -49,6 +63,24 @@ void GC_Light::Serialize(World &world, SaveFile &f)
 	f.Serialize(_timeout);
 	f.Serialize(_startTime);
 	f.Serialize(_type);
+
+	if (f.loading())
+		AddRenderRadius(world);
+}
+
+void GC_Light::AddRenderRadius(World &world) const
+{
+	world._lightRenderRadii[GetRenderRadius()]++;
+	world._maxLightRenderRadius = world._lightRenderRadii.rbegin()->first;
+}
+
+void GC_Light::RemoveRenderRadius(World &world) const
+{
+	auto it = world._lightRenderRadii.find(GetRenderRadius());
+	assert(world._lightRenderRadii.end() != it);
+	if( 0 == --it->second )
+		world._lightRenderRadii.erase(it);
+	world._maxLightRenderRadius = world._lightRenderRadii.empty() ? 0 : world._lightRenderRadii.rbegin()->first;
 }
 
 void GC_Light::SetTimeout(World &world, float t)
@@ -99,9 +131,9 @@ void GC_Spotlight::Init(World &world)
 	GC_MovingObject::Init(world);
 	_light = &world.New<GC_Light>(GetPos() + GetDirection() * 7, GC_Light::LIGHT_SPOT);
 	_light->SetActive(CheckFlags(GC_FLAG_SPOTLIGHT_ACTIVE));
-	_light->SetRadius(200);
+	_light->SetRadius(world, 200);
 	_light->SetIntensity(1.0f);
-	_light->SetOffset(170);
+	_light->SetOffset(world, 170);
 	_light->SetAspect(0.5f);
 	_light->SetLightDirection(GetDirection());
 }
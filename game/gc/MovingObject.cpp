@@ -4,11 +4,18 @@
 #include "inc/gc/WorldCfg.h"
 #include <MapFile.h>
 
-// Workaround for IMPLEMENT_GRID_MEMBER macro used in the base class
+// Workaround for IMPLEMENT_GRID_MEMBER macro used in the base class,
+// every change of grid_moving ends up here
 namespace base
 {
-	inline static void EnterContexts(World&, int, int){}
-	inline static void LeaveContexts(World&, int, int){}
+	inline static void EnterContexts(World &world, int locX, int locY)
+	{
+		++world.grid_moving_revisions.element(locX, locY);
+	}
+	inline static void LeaveContexts(World &world, int locX, int locY)
+	{
+		++world.grid_moving_revisions.element(locX, locY);
+	}
 }
 
 IMPLEMENT_GRID_MEMBER(base, GC_MovingObject, grid_moving)
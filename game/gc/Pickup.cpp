@@ -108,7 +108,7 @@ void GC_Pickup::Resume(World &world)
 		for (int n = 0; n < 50; ++n)
 		{
 			vec2d a = Vec2dDirection(PI2 * (float)n / 50);
-			world.New<GC_Particle>(GetPos() + a * 25, a * 25, PARTICLE_TYPE1, frand(0.5f) + 0.1f);
+			world.New<GC_Particle>(GetPos() + a * 25, a * 25, PARTICLE_TYPE1, world.net_frand(0.5f) + 0.1f);
 		}
 	}
 }
@@ -303,7 +303,7 @@ void GC_pu_Shield::TimeStep(World &world, float dt)
 void GC_pu_Shield::OnOwnerDamage(World &world, DamageDesc &dd)
 {
 	assert(_vehicle);
-	if( dd.damage > 5 || 0 == rand() % 4 || world.GetTime() - _timeHit > 0.2f )
+	if( dd.damage > 5 || 0 == world.net_rand() % 4 || world.GetTime() - _timeHit > 0.2f )
 	{
 		for( auto ls: world.eGC_pu_Shield._listeners )
 			ls->OnOwnerDamage(*this, dd);
@@ -314,8 +314,8 @@ void GC_pu_Shield::OnOwnerDamage(World &world, DamageDesc &dd)
 		vec2d v = _vehicle->_lv;
 		for( int i = 0; i < 7; i++ )
 		{
-			world.New<GC_Particle>(pos + dir * 26.0f + p * (float) (i<<1), v, PARTICLE_TYPE3, frand(0.4f)+0.1f);
-			world.New<GC_Particle>(pos + dir * 26.0f - p * (float) (i<<1), v, PARTICLE_TYPE3, frand(0.4f)+0.1f);
+			world.New<GC_Particle>(pos + dir * 26.0f + p * (float) (i<<1), v, PARTICLE_TYPE3, world.net_frand(0.4f)+0.1f);
+			world.New<GC_Particle>(pos + dir * 26.0f - p * (float) (i<<1), v, PARTICLE_TYPE3, world.net_frand(0.4f)+0.1f);
 		}
 	}
 	dd.damage *= 0.2f;
@@ -400,7 +400,9 @@ GC_Vehicle* GC_pu_Shock::FindNearVehicle(World &world, const GC_RigidBodyStatic
 	float min_dist = 20 * WORLD_BLOCK_SIZE;
 
 	GC_Vehicle *pNearTarget = nullptr;
-	FOREACH( world.GetList(LIST_vehicles), GC_Vehicle, pTargetObj )
+	std::vector<GC_Vehicle*> candidates;
+	world.QueryVehicles(GetPos(), min_dist, candidates);
+	for( GC_Vehicle *pTargetObj: candidates )
 	{
 		if( pTargetObj != ignore )
 		{
@@ -409,7 +411,7 @@ GC_Vehicle* GC_pu_Shock::FindNearVehicle(World &world, const GC_RigidBodyStatic
 
 			if( dist < min_dist )
 			{
-				GC_RigidBodyStatic *pObstacle = world.TraceNearest(world.grid_rigid_s,
+				GC_RigidBodyStatic *pObstacle = world.TraceNearestCached(
 					_vehicle, GetPos(), pTargetObj->GetPos() - GetPos());
 
 				if( pObstacle == pTargetObj )
@@ -446,10 +448,10 @@ void GC_pu_Shock::TimeStep(World &world, float dt)
 						_targetPos = pNearTarget->GetPos();
 
 						_light = &world.New<GC_Light>(GetPos(), GC_Light::LIGHT_DIRECT);
-						_light->SetRadius(100);
+						_light->SetRadius(world, 100);
 
 						vec2d tmp = _targetPos - GetPos();
-						_light->SetLength(tmp.len());
+						_light->SetLength(world, tmp.len());
 						_light->SetLightDirection(tmp.Normalize());
 
 						pNearTarget->TakeDamage(world, DamageDesc{ 1000, pNearTarget->GetPos(), _vehicle->GetOwner() });
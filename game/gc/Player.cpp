@@ -168,7 +168,7 @@ void GC_Player::Resume(World &world)
 		{
 			_vehicle->SetName(world, _vehname.c_str());
 		}
-		_vehicle->SetDirection(pBestPoint->GetDirection());
+		_vehicle->SetDirection(world, pBestPoint->GetDirection());
 		_vehicle->SetPlayer(world, this);
 
 		for (auto ls : world.eGC_Player._listeners)
@@ -34,6 +34,7 @@ GC_RigidBodyStatic::~GC_RigidBodyStatic()
 void GC_RigidBodyStatic::Init(World &world)
 {
 	GC_MovingObject::Init(world);
+	world.InvalidateTraces(GetPos());
 	if( GetObstacleFlags() && world._field )
 		world._field->ProcessObject(world, this, true);
 }
@@ -42,18 +43,30 @@ void GC_RigidBodyStatic::Kill(World &world)
 {
 	if( GetObstacleFlags() && world._field )
 		world._field->ProcessObject(world, this, false);
+	world.InvalidateTraces(GetPos());
 	GC_MovingObject::Kill(world);
 }
 
 void GC_RigidBodyStatic::MoveTo(World &world, const vec2d &pos)
 {
-	if( GetObstacleFlags() && world._field )
-		world._field->ProcessObject(world, this, false);
+	vec2d oldPos = GetPos();
+	if( oldPos != pos )
+	{
+		world.InvalidateTraces(oldPos);
+		world.InvalidateTraces(pos);
+	}
 
 	GC_MovingObject::MoveTo(world, pos);
 
 	if( GetObstacleFlags() && world._field )
-		world._field->ProcessObject(world, this, true);
+		world._field->MoveObject(world, this, oldPos);
+}
+
+void GC_RigidBodyStatic::SetDirection(World &world, const vec2d &d)
+{
+	if( GetDirection() != d )
+		world.InvalidateTraces(GetPos());
+	GC_MovingObject::SetDirection(d);
 }
 
 bool GC_RigidBodyStatic::IntersectWithLine(const vec2d &lineCenter, const vec2d &lineDirection,
@@ -449,6 +462,7 @@ void GC_RigidBodyStatic::MyPropertySet::MyExchange(World &world, bool applyToObj
 
 	if( applyToObject )
 	{
+		world.InvalidateTraces(tmp->GetPos());
 		tmp->_scriptOnDestroy = _propOnDestroy.GetStringValue();
 		tmp->_scriptOnDamage  = _propOnDamage.GetStringValue();
 		tmp->SetHealth(std::min(_propMaxHealth.GetFloatValue(), _propHealth.GetFloatValue()),
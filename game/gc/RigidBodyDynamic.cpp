@@ -67,7 +67,7 @@ void GC_RigidBodyDynamic::MyPropertySet::MyExchange(World &world, bool applyToOb
 		tmp->_Nx = _propNx.GetFloatValue();
 		tmp->_Ny = _propNy.GetFloatValue();
 		tmp->_Nw = _propNw.GetFloatValue();
-		tmp->SetDirection(Vec2dDirection(_propRotation.GetFloatValue()));
+		tmp->SetDirection(world, Vec2dDirection(_propRotation.GetFloatValue()));
 	}
 	else
 	{
@@ -88,7 +88,6 @@ IMPLEMENT_1LIST_MEMBER(GC_RigidBodyStatic, GC_RigidBodyDynamic, LIST_timestep);
 
 GC_RigidBodyDynamic::ContactList GC_RigidBodyDynamic::_contacts;
 std::stack<GC_RigidBodyDynamic::ContactList> GC_RigidBodyDynamic::_contactsStack;
-bool GC_RigidBodyDynamic::_glob_parity = false;
 
 GC_RigidBodyDynamic::GC_RigidBodyDynamic(vec2d pos)
 	: GC_RigidBodyStatic(pos)
@@ -109,8 +108,6 @@ GC_RigidBodyDynamic::GC_RigidBodyDynamic(vec2d pos)
 	, _external_impulse()
 	, _external_torque(0)
 {
-	if( _glob_parity )
-		SetFlags(GC_FLAG_RBDYMAMIC_PARITY, true);
 }
 
 GC_RigidBodyDynamic::GC_RigidBodyDynamic(FromFile)
@@ -138,7 +135,8 @@ void GC_RigidBodyDynamic::MapExchange(MapFile &f)
 	MAP_EXCHANGE_FLOAT(rotation, rotTmp, 0);
 	if( f.loading() )
 	{
-		SetDirection(Vec2dDirection(rotTmp));
+		// not in the world yet, Init outdates the traces
+		GC_MovingObject::SetDirection(Vec2dDirection(rotTmp));
 	}
 }
 
@@ -222,7 +220,7 @@ void GC_RigidBodyDynamic::TimeStep(World &world, float dt)
 	MoveTo(world, GetPos() + dx);
 	vec2d dirTmp = Vec2dAddDirection(GetDirection(), da);
 	dirTmp.Normalize();
-	SetDirection(dirTmp);
+	SetDirection(world, dirTmp);
 
 
 	//
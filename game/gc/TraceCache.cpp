@@ -0,0 +1,79 @@
+#include "inc/gc/TraceCache.h"
+#include "inc/gc/WorldCfg.h"
+#include <functional>
+
+size_t TraceCache::KeyHash::operator()(const Key &key) const
+{
+	std::hash<float> hf;
+	size_t h = std::hash<const void*>()(key.ignore);
+	for( float f: { key.x0.x, key.x0.y, key.a.x, key.a.y } )
+		h = h * 31 + hf(f);
+	return h;
+}
+
+TraceCache::TraceCache(RectRB locationBounds)
+	: _bounds(locationBounds)
+	, _revisions(WIDTH(locationBounds) * HEIGHT(locationBounds))
+{
+}
+
+void TraceCache::Invalidate(int locX, int locY)
+{
+	assert(PtInRect(_bounds, locX, locY));
+	_revisions[(locX - _bounds.left) + (locY - _bounds.top) * WIDTH(_bounds)] = ++_revision;
+}
+
+bool TraceCache::IsValid(const Key &key, const Entry &entry) const
+{
+	// same range of locations as World::RayTrace visits
+	vec2d begin = key.x0 / WORLD_LOCATION_SIZE;
+	vec2d end = (key.x0 + key.a) / WORLD_LOCATION_SIZE;
+	int xmin = std::max(_bounds.left, (int)std::floor(std::min(begin.x, end.x) - 0.5f));
+	int ymin = std::max(_bounds.top, (int)std::floor(std::min(begin.y, end.y) - 0.5f));
+	int xmax = std::min(_bounds.right - 1, (int)std::floor(std::max(begin.x, end.x) + 0.5f));
+	int ymax = std::min(_bounds.bottom - 1, (int)std::floor(std::max(begin.y, end.y) + 0.5f));
+
+	for( int y = ymin; y <= ymax; ++y )
+	{
+		for( int x = xmin; x <= xmax; ++x )
+		{
+			if( _revisions[(x - _bounds.left) + (y - _bounds.top) * WIDTH(_bounds)] > entry.revision )
+				return false;
+		}
+	}
+	return true;
+}
+
+bool TraceCache::Find(const GC_RigidBodyStatic *ignore, vec2d x0, vec2d a, GC_RigidBodyStatic *&result)
+{
+	Key key = { ignore, x0, a };
+	auto it = _entries.find(key);
+	if( _entries.end() != it && IsValid(key, it->second) )
+	{
+		it->second.step = _step;
+		result = it->second.result;
+		_stats.hits++;
+		return true;
+	}
+	_stats.misses++;
+	return false;
+}
+
+void TraceCache::Store(const GC_RigidBodyStatic *ignore, vec2d x0, vec2d a, GC_RigidBodyStatic *result)
+{
+	_entries[Key{ ignore, x0, a }] = Entry{ result, _revision, _step };
+}
+
+void TraceCache::NextStep()
+{
+	for( auto it = _entries.begin(); it != _entries.end(); )
+	{
+		if( it->second.step != _step )
+			it = _entries.erase(it);
+		else
+			++it;
+	}
+	_step++;
+	_lastStats = _stats;
+	_stats = Stats();
+}
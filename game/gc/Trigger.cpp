@@ -38,8 +38,7 @@ GC_Trigger::~GC_Trigger()
 
 bool GC_Trigger::GetVisible(World &world, const GC_Vehicle *v) const
 {
-	GC_RigidBodyStatic *object = world.TraceNearest(
-		world.grid_rigid_s, nullptr, GetPos(), v->GetPos() - GetPos());
+	GC_RigidBodyStatic *object = world.TraceNearestCached(nullptr, GetPos(), v->GetPos() - GetPos());
 	return object == v;
 }
 
@@ -107,7 +106,9 @@ void GC_Trigger::TimeStep(World &world, float dt)
 
 		// find nearest vehicle
 		float rr_min = _radius * _radius * WORLD_BLOCK_SIZE * WORLD_BLOCK_SIZE;
-		FOREACH( world.GetList(LIST_vehicles), GC_Vehicle, veh )
+		std::vector<GC_Vehicle*> candidates;
+		world.QueryVehicles(GetPos(), _radius * WORLD_BLOCK_SIZE, candidates);
+		for( GC_Vehicle *veh: candidates )
 		{
 			if( !veh->GetOwner()
 				|| (CheckFlags(GC_FLAG_TRIGGER_ONLYHUMAN)
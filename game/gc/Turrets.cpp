@@ -58,21 +58,65 @@ void GC_Turret::Serialize(World &world, SaveFile &f)
 	f.Serialize(_team);
 	f.Serialize(_target);
 
-	if( f.loading() && (TS_WAITING == _state || TS_HIDDEN == _state) )
+	if( f.loading() )
+		EnterSensors(world);
+}
+
+RectRB GC_Turret::GetSensorBounds(const World &world) const
+{
+	// vehicles outside of the world are kept in the border locations
+	const RectRB &lb = world.GetLocationBounds();
+	auto clampX = [&](float x) { return std::max(lb.left, std::min((int)std::floor(x / WORLD_LOCATION_SIZE), lb.right - 1)); };
+	auto clampY = [&](float y) { return std::max(lb.top, std::min((int)std::floor(y / WORLD_LOCATION_SIZE), lb.bottom - 1)); };
+	return RectRB{
+		clampX(GetPos().x - _sight),
+		clampY(GetPos().y - _sight),
+		clampX(GetPos().x + _sight) + 1,
+		clampY(GetPos().y + _sight) + 1 };
+}
+
+void GC_Turret::EnterSensors(World &world)
+{
+	RectRB bounds = GetSensorBounds(world);
+	for( int y = bounds.top; y < bounds.bottom; y++ )
+		for( int x = bounds.left; x < bounds.right; x++ )
+			world.grid_sensors.element(x, y).insert(this);
+}
+
+void GC_Turret::LeaveSensors(World &world)
+{
+	RectRB bounds = GetSensorBounds(world);
+	for( int y = bounds.top; y < bounds.bottom; y++ )
 	{
-		world._jobManager.RegisterMember(this);
+		for( int x = bounds.left; x < bounds.right; x++ )
+		{
+			auto &cell = world.grid_sensors.element(x, y);
+			for( auto id = cell.begin(); id != cell.end(); id = cell.next(id) )
+			{
+				if( cell.at(id) == this )
+				{
+					cell.erase(id);
+					break;
+				}
+			}
+		}
 	}
 }
 
 GC_Vehicle* GC_Turret::EnumTargets(World &world)
 {
+	if( !GetAlert() )
+		return nullptr;
+
 	float min_dist = _sight*_sight;
 	float dist;
 
 	GC_Vehicle *target = nullptr;
 	GC_RigidBodyStatic *pObstacle = nullptr;
 
-	FOREACH( world.GetList(LIST_vehicles), GC_Vehicle, pDamObj )
+	std::vector<GC_Vehicle*> candidates;
+	world.QueryVehicles(GetPos(), _sight, candidates);
+	for( GC_Vehicle *pDamObj: candidates )
 	{
 		if( !pDamObj->GetOwner() ||
 			(pDamObj->GetOwner()->GetTeam() && pDamObj->GetOwner()->GetTeam() == _team) )
@@ -90,6 +134,17 @@ GC_Vehicle* GC_Turret::EnumTargets(World &world)
 		}
 	}
 
+	if( !target )
+	{
+		// sleep until a vehicle enters one of the sensor locations
+		bool vehiclesNear = false;
+		RectRB bounds = GetSensorBounds(world);
+		for( int y = bounds.top; y < bounds.bottom && !vehiclesNear; y++ )
+			for( int x = bounds.left; x < bounds.right && !vehiclesNear; x++ )
+				vehiclesNear = !world.grid_vehicles.element(x, y).empty();
+		SetFlags(GC_FLAG_TURRET_ALERT, vehiclesNear);
+	}
+
 	return target;
 }
 
@@ -105,22 +160,20 @@ void GC_Turret::SetFire(World &world, bool fire)
 
 void GC_Turret::SelectTarget(World &world, GC_Vehicle *target)
 {
-	world._jobManager.UnregisterMember(this);
 	_target = target;
 	SetState(world, TS_ATACKING);
 }
 
 void GC_Turret::TargetLost(World &world)
 {
-	world._jobManager.RegisterMember(this);
+	Alert();
 	_target = nullptr;
 	_state  = TS_WAITING;
 }
 
 bool GC_Turret::IsTargetVisible(World &world, GC_Vehicle* target, GC_RigidBodyStatic** pObstacle)
 {
-	GC_RigidBodyStatic *object = world.TraceNearest(
-		world.grid_rigid_s, this, GetPos(), target->GetPos() - GetPos());
+	GC_RigidBodyStatic *object = world.TraceNearestCached(this, GetPos(), target->GetPos() - GetPos());
 
 	if( object != target )
 	{
@@ -144,11 +197,8 @@ void GC_Turret::ProcessState(World &world, float dt)
 	switch( GetState() )
 	{
 	case TS_WAITING:
-		if( world._jobManager.TakeJob(this) )
-		{
-			if( GC_Vehicle *target = EnumTargets(world) )
-				SelectTarget(world, target);
-		}
+		if( GC_Vehicle *target = EnumTargets(world) )
+			SelectTarget(world, target);
 		break;
 	case TS_ATACKING:
 	{
@@ -200,7 +250,7 @@ void GC_Turret::TimeStep(World &world, float dt)
 	}
 }
 
-void GC_Turret::SetInitialDir(float initialDir)
+void GC_Turret::SetInitialDir(World &world, float initialDir)
 {
 	_dir = initialDir;
 	_initialDir = _dir;
@@ -209,7 +259,8 @@ void GC_Turret::SetInitialDir(float initialDir)
 void GC_Turret::Init(World &world)
 {
 	GC_RigidBodyStatic::Init(world);
-	world._jobManager.RegisterMember(this);
+	EnterSensors(world);
+	Alert();
 }
 
 void GC_Turret::Kill(World &world)
@@ -221,13 +272,18 @@ void GC_Turret::Kill(World &world)
 		for( auto ls: world.eGC_Turret._listeners )
 			ls->OnRotationStateChange(*this);
 	}
-	if (TS_WAITING == _state || TS_HIDDEN == _state)
-	{
-		world._jobManager.UnregisterMember(this);
-	}
+	LeaveSensors(world);
 	GC_RigidBodyStatic::Kill(world);
 }
 
+void GC_Turret::MoveTo(World &world, const vec2d &pos)
+{
+	LeaveSensors(world);
+	GC_RigidBodyStatic::MoveTo(world, pos);
+	EnterSensors(world);
+	Alert();
+}
+
 void GC_Turret::MapExchange(MapFile &f)
 {
 	GC_RigidBodyStatic::MapExchange(f);
@@ -307,8 +363,11 @@ void GC_Turret::MyPropertySet::MyExchange(World &world, bool applyToObject)
 	if( applyToObject )
 	{
 		tmp->_team  = _propTeam.GetIntValue();
+		tmp->LeaveSensors(world);
 		tmp->_sight = (float) (_propSight.GetIntValue() * WORLD_BLOCK_SIZE);
-		tmp->SetInitialDir(_propDir.GetFloatValue());
+		tmp->EnterSensors(world);
+		tmp->Alert();
+		tmp->SetInitialDir(world, _propDir.GetFloatValue());
 	}
 	else
 	{
@@ -432,7 +491,7 @@ void GC_TurretCannon::TimeStep(World &world, float dt)
 			world.New<GC_Particle>(GetPos() + Vec2dDirection(GetWeaponDir()) * 33.0f,
 			                       SPEED_SMOKE + Vec2dDirection(GetWeaponDir()) * 50,
 			                       PARTICLE_SMOKE,
-			                       frand(0.3f) + 0.2f);
+			                       world.net_frand(0.3f) + 0.2f);
 		}
 	}
 }
@@ -477,7 +536,8 @@ void GC_TurretBunker::MapExchange(MapFile &f)
 	GC_Turret::MapExchange(f);
 	if( f.loading() )
 	{
-		SetDirection(Vec2dDirection(_initialDir));
+		// not in the world yet, Init outdates the traces
+		GC_MovingObject::SetDirection(Vec2dDirection(_initialDir));
 	}
 }
 
@@ -487,14 +547,12 @@ GC_TurretBunker::~GC_TurretBunker()
 
 void GC_TurretBunker::WakeUp(World &world)
 {
-	world._jobManager.UnregisterMember(this);
 	SetState(world, TS_WAKING_UP);
 }
 
 void GC_TurretBunker::WakeDown(World &world)
 {
 	SetState(world, TS_PREPARE_TO_WAKEDOWN);
-	world._jobManager.UnregisterMember(this);
 }
 
 void GC_TurretBunker::OnDamage(World &world, DamageDesc &dd)
@@ -557,20 +615,14 @@ void GC_TurretBunker::ProcessState(World &world, float dt)
 		}
 		else
 		{
-		//	if( _jobManager.TakeJob(this) )
-			{
-				if( GC_Vehicle *target = EnumTargets(world) )
-					SelectTarget(world, target);
-			}
+			if( GC_Vehicle *target = EnumTargets(world) )
+				SelectTarget(world, target);
 		}
 		break;
 
 	case TS_HIDDEN:
-		if( world._jobManager.TakeJob(this) )
-		{
-			if( EnumTargets(world) )
-                WakeUp(world);
-		}
+		if( EnumTargets(world) )
+			WakeUp(world);
 		break;
 
 	case TS_WAKING_UP:
@@ -579,7 +631,7 @@ void GC_TurretBunker::ProcessState(World &world, float dt)
 		{
 			_time_wake = _time_wake_max;
 			SetState(world, TS_WAITING);
-			world._jobManager.RegisterMember(this);
+			Alert();
 		}
 		break;
 
@@ -589,7 +641,7 @@ void GC_TurretBunker::ProcessState(World &world, float dt)
 		{
 			_time_wake = 0;
 			SetState(world, TS_HIDDEN);
-			world._jobManager.RegisterMember(this);
+			Alert();
 		}
 		break;
 
@@ -610,11 +662,11 @@ void GC_TurretBunker::ProcessState(World &world, float dt)
 	SetFire(world, fire);
 }
 
-void GC_TurretBunker::SetInitialDir(float initialDir)
+void GC_TurretBunker::SetInitialDir(World &world, float initialDir)
 {
 	_initialDir = initialDir;
 	_dir = _initialDir;
-	SetDirection(Vec2dDirection(_initialDir));
+	SetDirection(world, Vec2dDirection(_initialDir));
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -678,7 +730,7 @@ void GC_TurretMinigun::OnShoot(World &world)
 	float ang = _dir + world.net_frand(0.1f) - 0.05f;
 	vec2d a = Vec2dDirection(_dir);
 	world.New<GC_Bullet>(GetPos() + a * 31.9f, Vec2dDirection(ang) * SPEED_BULLET, this, nullptr, false);
-	world.New<GC_Particle>(GetPos() + a * 31.9f, a * (400 + frand(400.0f)), PARTICLE_TYPE1, frand(0.06f) + 0.03f);
+	world.New<GC_Particle>(GetPos() + a * 31.9f, a * (400 + world.net_frand(400.0f)), PARTICLE_TYPE1, world.net_frand(0.06f) + 0.03f);
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -14,6 +14,7 @@
 
 
 IMPLEMENT_1LIST_MEMBER(GC_RigidBodyDynamic, GC_Vehicle, LIST_vehicles);
+IMPLEMENT_GRID_MEMBER(GC_RigidBodyDynamic, GC_Vehicle, grid_vehicles);
 
 GC_Vehicle::GC_Vehicle(vec2d pos)
   : GC_RigidBodyDynamic(pos)
@@ -38,22 +39,23 @@ GC_Vehicle::~GC_Vehicle()
 void GC_Vehicle::Init(World &world)
 {
 	GC_RigidBodyDynamic::Init(world);
+	world.AlertSensors(_locationX, _locationY);
 
 	_light_ambient = &world.New<GC_Light>(GetPos(), GC_Light::LIGHT_POINT);
 	_light_ambient->SetIntensity(0.8f);
-	_light_ambient->SetRadius(150);
+	_light_ambient->SetRadius(world, 150);
 
 	_light1 = &world.New<GC_Light>(GetLightPos1(), GC_Light::LIGHT_SPOT);
 	_light2 = &world.New<GC_Light>(GetLightPos2(), GC_Light::LIGHT_SPOT);
 
-	_light1->SetRadius(300);
-	_light2->SetRadius(300);
+	_light1->SetRadius(world, 300);
+	_light2->SetRadius(world, 300);
 
 	_light1->SetIntensity(0.9f);
 	_light2->SetIntensity(0.9f);
 
-	_light1->SetOffset(290);
-	_light2->SetOffset(290);
+	_light1->SetOffset(world, 290);
+	_light2->SetOffset(world, 290);
 
 	_light1->SetAspect(0.4f);
 	_light2->SetAspect(0.4f);
@@ -192,6 +194,7 @@ void GC_Vehicle::SetPlayer(World &world, GC_Player *player)
 			SetClass(*vc);
 		SetSkin(std::string("skin/").append(_player->GetSkin()));
 	}
+	world.InvalidateTraces(GetPos()); // new size and direction
 }
 
 void GC_Vehicle::Kill(World &world)
@@ -240,6 +243,7 @@ void GC_Vehicle::SetWeapon(World &world, GC_Weapon *weapon)
 			if( auto vc = GetVehicleClass(GetOwner()->GetClass()) )
 				SetClass(*vc);
 		}
+		world.InvalidateTraces(GetPos());
 	}
 }
 
@@ -252,7 +256,17 @@ void GC_Vehicle::MoveTo(World &world, const vec2d &pos)
 		_shield->MoveTo(world, pos);
 		_shield->SetDirection(GetDirection());
 	}
-	GC_MovingObject::MoveTo(world, pos);
+	if( GetPos() != pos )
+	{
+		world.InvalidateTraces(GetPos());
+		world.InvalidateTraces(pos);
+	}
+
+	int locX = _locationX;
+	int locY = _locationY;
+	GC_MovingObject::MoveTo(world, pos); // vehicles are not obstacles on the field
+	if( locX != _locationX || locY != _locationY )
+		world.AlertSensors(_locationX, _locationY);
 }
 
 void GC_Vehicle::SetControllerState(const VehicleState &vs)
@@ -310,7 +324,7 @@ void GC_Vehicle::TimeStep(World &world, float dt)
 		float smoke_dt = 1.0f / (60.0f * (1.0f - GetHealth() / (GetHealthMax() * 0.5f)));
 		for(; _time_smoke > 0; _time_smoke -= smoke_dt)
 		{
-			world.New<GC_Particle>(GetPos() + vrand(frand(24.0f)), SPEED_SMOKE, PARTICLE_SMOKE, 1.5f, frand(1.0f));
+			world.New<GC_Particle>(GetPos() + world.net_vrand(world.net_frand(24.0f)), SPEED_SMOKE, PARTICLE_SMOKE, 1.5f, world.net_frand(1.0f));
 		}
 	}
 
@@ -31,42 +31,18 @@ GC_Wall::~GC_Wall()
 {
 }
 
-static void RemoveCorner(World &world, GC_RigidBodyStatic &obj, int corner)
+static void RemoveCorner(World &world, GC_RigidBodyStatic &obj)
 {
 	assert(world._field);
-	if (corner)
+	int x, y;
+	if (obj.GetPassableFieldCell(world, x, y))
 	{
-		vec2d p = obj.GetPos() / WORLD_BLOCK_SIZE;
-		int x, y;
-		switch( corner )
-		{
-			default:
-				assert(false);
-			case 1:
-				x = (int)std::floor(p.x+1);
-				y = (int)std::floor(p.y+1);
-				break;
-			case 2:
-				x = (int)std::floor(p.x);
-				y = (int)std::floor(p.y + 1);
-				break;
-			case 3:
-				x = (int)std::floor(p.x);
-				y = (int)std::floor(p.y);
-				break;
-			case 4:
-				x = (int)std::floor(p.x + 1);
-				y = (int)std::floor(p.y);
-				break;
-		}
 		auto blockBounds = world.GetBlockBounds();
-		x = std::max(blockBounds.left, std::min(x, blockBounds.right));
-		y = std::max(blockBounds.top, std::min(y, blockBounds.bottom));
-
 		auto &field = *world._field;
 		field(x - blockBounds.left, y - blockBounds.top).RemoveObject(world, obj.GetId());
 		if( blockBounds.left == x || blockBounds.top == y || blockBounds.right == x || blockBounds.bottom == y )
 			field(x - blockBounds.left, y - blockBounds.top)._obstacleFlags = 0xFF;
+		field.InvalidateCells(x - blockBounds.left, y - blockBounds.top, x - blockBounds.left, y - blockBounds.top);
 	}
 }
 
@@ -75,7 +51,7 @@ void GC_Wall::Init(World &world)
 	GC_RigidBodyStatic::Init(world); // adds all corners
 	if (world._field)
 	{
-		RemoveCorner(world, *this, GetCorner());
+		RemoveCorner(world, *this);
 	}
 }
 
@@ -416,7 +392,7 @@ void GC_Wall::Serialize(World &world, SaveFile &f)
 
 	if( f.loading() && world._field)
 	{
-		RemoveCorner(world, *this, GetCorner());
+		RemoveCorner(world, *this);
 	}
 }
 
@@ -424,9 +400,9 @@ void GC_Wall::OnDestroy(World &world, const DamageDesc &dd)
 {
 	for( int n = 0; n < 5; ++n )
 	{
-		world.New<GC_BrickFragment>(GetPos() + vrand(GetRadius()), vec2d{ frand(100.0f) - 50, -frand(100.0f) });
+		world.New<GC_BrickFragment>(GetPos() + world.net_vrand(GetRadius()), vec2d{ world.net_frand(100.0f) - 50, -world.net_frand(100.0f) });
 	}
-	world.New<GC_Particle>(GetPos(), SPEED_SMOKE, PARTICLE_SMOKE, frand(0.2f) + 0.3f);
+	world.New<GC_Particle>(GetPos(), SPEED_SMOKE, PARTICLE_SMOKE, world.net_frand(0.2f) + 0.3f);
 
 	GC_RigidBodyStatic::OnDestroy(world, dd);
 }
@@ -446,10 +422,10 @@ void GC_Wall::OnDamage(World &world, DamageDesc &dd)
 			v.x = 0;
 			v.y = v.y > 0 ? 50.0f : -50.0f;
 		}
-		v += vrand(25);
+		v += world.net_vrand(25);
 
 		world.New<GC_BrickFragment>(dd.hit, v*2.5f);
-		world.New<GC_Particle>(dd.hit + vrand(8), SPEED_SMOKE, PARTICLE_SMOKE, frand(0.2f) + 0.3f);
+		world.New<GC_Particle>(dd.hit + world.net_vrand(8), SPEED_SMOKE, PARTICLE_SMOKE, world.net_frand(0.2f) + 0.3f);
 	}
 	GC_RigidBodyStatic::OnDamage(world, dd);
 }
@@ -457,45 +433,54 @@ void GC_Wall::OnDamage(World &world, DamageDesc &dd)
 void GC_Wall::SetCorner(World &world, unsigned int index) // 0 means normal view
 {
 	// restore current corner
-	vec2d p = GetPos() / WORLD_BLOCK_SIZE;
-	if (world._field && CheckFlags(GC_FLAG_WALL_CORNER_ALL))
+	int x, y;
+	if (world._field && GetPassableFieldCell(world, x, y))
 	{
-		int x, y;
-		switch (GetCorner())
-		{
-		default:
-			assert(false);
-		case 1:
-			x = (int)std::floor(p.x + 1);
-			y = (int)std::floor(p.y + 1);
-			break;
-		case 2:
-			x = (int)std::floor(p.x);
-			y = (int)std::floor(p.y + 1);
-			break;
-		case 3:
-			x = (int)std::floor(p.x);
-			y = (int)std::floor(p.y);
-			break;
-		case 4:
-			x = (int)std::floor(p.x + 1);
-			y = (int)std::floor(p.y);
-			break;
-		}
 		auto blockBounds = world.GetBlockBounds();
-		x = std::max(blockBounds.left, std::min(x, blockBounds.right));
-		y = std::max(blockBounds.top, std::min(y, blockBounds.bottom));
-
 		(*world._field)(x - blockBounds.left, y - blockBounds.top).AddObject(world, GetId());
+		world._field->InvalidateCells(x - blockBounds.left, y - blockBounds.top, x - blockBounds.left, y - blockBounds.top);
 	}
 
 	SetFlags(GC_FLAG_WALL_CORNER_ALL, false);
 	SetFlags(FlagsFromCornerIndex(index), true);
+	world.InvalidateTraces(GetPos());
 
 	if (world._field)
 	{
-		RemoveCorner(world, *this, GetCorner());
+		RemoveCorner(world, *this);
+	}
+}
+
+bool GC_Wall::GetPassableFieldCell(const World &world, int &x, int &y) const
+{
+	vec2d p = GetPos() / WORLD_BLOCK_SIZE;
+	switch (GetCorner())
+	{
+	case 0:
+		return false;
+	default:
+		assert(false);
+	case 1:
+		x = (int)std::floor(p.x + 1);
+		y = (int)std::floor(p.y + 1);
+		break;
+	case 2:
+		x = (int)std::floor(p.x);
+		y = (int)std::floor(p.y + 1);
+		break;
+	case 3:
+		x = (int)std::floor(p.x);
+		y = (int)std::floor(p.y);
+		break;
+	case 4:
+		x = (int)std::floor(p.x + 1);
+		y = (int)std::floor(p.y);
+		break;
 	}
+	auto blockBounds = world.GetBlockBounds();
+	x = std::max(blockBounds.left, std::min(x, blockBounds.right));
+	y = std::max(blockBounds.top, std::min(y, blockBounds.bottom));
+	return true;
 }
 
 unsigned int GC_Wall::GetCorner() const
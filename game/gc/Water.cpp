@@ -32,9 +32,9 @@ void GC_Water::MoveTo(World &world, const vec2d &pos)
 	if (oldTile != newTile)
 	{
 		if (-1 != oldTile)
-			world._waterTiles[oldTile] = false;
+			world.SetWaterTile(oldTile, false);
 		if (-1 != newTile)
-			world._waterTiles[newTile] = true;
+			world.SetWaterTile(newTile, true);
 	}
 	GC_RigidBodyStatic::MoveTo(world, pos);
 }
@@ -45,7 +45,7 @@ void GC_Water::Init(World &world)
 	int tileIndex = world.GetTileIndex(GetPos());
 	if (-1 != tileIndex)
 	{
-		world._waterTiles[tileIndex] = true;
+		world.SetWaterTile(tileIndex, true);
 	}
 }
 
@@ -54,7 +54,7 @@ void GC_Water::Kill(World &world)
 	int tileIndex = world.GetTileIndex(GetPos());
 	if (-1 != tileIndex)
 	{
-		world._waterTiles[tileIndex] = false;
+		world.SetWaterTile(tileIndex, false);
 	}
 	GC_RigidBodyStatic::Kill(world);
 }
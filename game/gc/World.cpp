@@ -4,6 +4,9 @@
 #include "inc/gc/WorldCfg.h"
 #include "inc/gc/WorldEvents.h"
 #include "inc/gc/RigidBodyDynamic.h"
+#include "inc/gc/TraceCache.h"
+#include "inc/gc/Turrets.h"
+#include "inc/gc/Vehicle.h"
 #include "inc/gc/Player.h"
 #include "inc/gc/Macros.h"
 #include "inc/gc/TypeSystem.h"
@@ -12,9 +15,13 @@
 
 #include <fs/FileSystem.h>
 #include <MapFile.h>
+#include <atomic>
 #include <cfloat>
+#include <exception>
 #include <sstream>
 
+static std::atomic<unsigned int> s_lastSerial;
+
 static int DivFloor(int number, unsigned int denominator)
 {
 	if (number < 0)
@@ -52,6 +59,7 @@ World::World(RectRB blockBounds, bool initField)
 		DivFloor(blockBounds.top * WORLD_BLOCK_SIZE, WORLD_LOCATION_SIZE),
 		DivCeil(blockBounds.right * WORLD_BLOCK_SIZE, WORLD_LOCATION_SIZE),
 		DivCeil(blockBounds.bottom * WORLD_BLOCK_SIZE, WORLD_LOCATION_SIZE) }
+	, _serial(++s_lastSerial) // worlds are loaded on background threads
 #ifdef NETWORK_DEBUG
 	, _checksum(0)
 	, _frame(0)
@@ -64,6 +72,11 @@ World::World(RectRB blockBounds, bool initField)
 	grid_walls.resize(_locationBounds);
 	grid_pickup.resize(_locationBounds);
 	grid_moving.resize(_locationBounds);
+	grid_vehicles.resize(_locationBounds);
+	grid_sensors.resize(_locationBounds);
+	grid_lights.resize(_locationBounds);
+	grid_moving_revisions.resize(_locationBounds);
+	_traceCache = std::make_unique<TraceCache>(_locationBounds);
 
 	if (initField)
 	{
@@ -72,6 +85,7 @@ World::World(RectRB blockBounds, bool initField)
 	}
 	_waterTiles.resize(WIDTH(_blockBounds) * HEIGHT(_blockBounds));
 	_woodTiles.resize(WIDTH(_blockBounds) * HEIGHT(_blockBounds));
+	_waterNeighbors.resize(WIDTH(_blockBounds) * HEIGHT(_blockBounds));
 }
 
 int World::GetTileIndex(vec2d pos) const
@@ -89,6 +103,33 @@ int World::GetTileIndex(int blockX, int blockY) const
 		return -1;
 }
 
+//                                         LT  CT  RT    LC  RC    LB  CB  RB
+const int World::WATER_NEIGHBOR_DX[8] = { -1,  0,  1,   -1,  1,   -1,  0,  1 };
+const int World::WATER_NEIGHBOR_DY[8] = { -1, -1, -1,    0,  0,    1,  1,  1 };
+
+void World::SetWaterTile(int tileIndex, bool water)
+{
+	assert(tileIndex >= 0 && tileIndex < (int)_waterTiles.size());
+	if (_waterTiles[tileIndex] == water)
+		return;
+	_waterTiles[tileIndex] = water;
+
+	int x0 = _blockBounds.left + tileIndex % WIDTH(_blockBounds);
+	int y0 = _blockBounds.top + tileIndex / WIDTH(_blockBounds);
+	for (int i = 0; i < 8; i++)
+	{
+		// this block is the i-th neighbor of the block on the opposite side
+		int neighborIndex = GetTileIndex(x0 - WATER_NEIGHBOR_DX[i], y0 - WATER_NEIGHBOR_DY[i]);
+		if (-1 != neighborIndex)
+		{
+			if (water)
+				_waterNeighbors[neighborIndex] |= 1u << i;
+			else
+				_waterNeighbors[neighborIndex] &= ~(1u << i);
+		}
+	}
+}
+
 void World::OnKill(GC_Object &obj)
 {
 	for( auto ls: eWorld._listeners )
@@ -193,6 +234,26 @@ void World::Import(MapFile &file)
 	file.getMapAttribute("theme",    _infoTheme);
 	file.getMapAttribute("on_init",  _infoOnInit);
 
+	// Objects don't touch the AI field while loading, it is built in a single pass afterwards
+	std::unique_ptr<Field> field = std::move(_field);
+	std::exception_ptr error;
+	try
+	{
+		ImportObjects(file);
+	}
+	catch (...)
+	{
+		error = std::current_exception();
+	}
+	_field = std::move(field);
+	if (_field)
+		_field->Build(*this);
+	if (error)
+		std::rethrow_exception(error);
+}
+
+void World::ImportObjects(MapFile &file)
+{
 	while( file.ReadNextObject() )
 	{
 		ObjectType t = RTTypes::Inst().GetTypeByName(file.GetCurrentClassName());
@@ -319,7 +380,7 @@ bool World::CalcOutstrip( vec2d origin,
                           float projectileSpeed,
                           vec2d targetPos,
                           vec2d targetVelocity,
-                          vec2d &out_fake) // out: fake target position
+                          vec2d &out_fake) const // out: fake target position
 {
 	float vt = targetVelocity.len();
 
@@ -433,6 +494,52 @@ void World::TraceAll( const Grid<ObjectList> &list,
 	RayTrace(list, selector);
 }
 
+GC_RigidBodyStatic* World::TraceNearestCached(const GC_RigidBodyStatic* ignore, const vec2d &x0, const vec2d &a)
+{
+	GC_RigidBodyStatic *result;
+	if( !_traceCache->Find(ignore, x0, a, result) )
+	{
+		result = TraceNearest(grid_rigid_s, ignore, x0, a);
+		_traceCache->Store(ignore, x0, a, result);
+	}
+	return result;
+}
+
+void World::InvalidateTraces(const vec2d &pos)
+{
+	int locX = std::max(_locationBounds.left, std::min((int)std::floor(pos.x / WORLD_LOCATION_SIZE), _locationBounds.right - 1));
+	int locY = std::max(_locationBounds.top, std::min((int)std::floor(pos.y / WORLD_LOCATION_SIZE), _locationBounds.bottom - 1));
+	_traceCache->Invalidate(locX, locY);
+}
+
+void World::QueryVehicles(const vec2d &center, float radius, std::vector<GC_Vehicle*> &result)
+{
+	std::vector<ObjectList*> receive;
+	FRECT rt = {
+		(center.x - radius) / WORLD_LOCATION_SIZE,
+		(center.y - radius) / WORLD_LOCATION_SIZE,
+		(center.x + radius) / WORLD_LOCATION_SIZE,
+		(center.y + radius) / WORLD_LOCATION_SIZE};
+	grid_vehicles.OverlapRect(receive, rt);
+
+	for( ObjectList *ls: receive )
+	{
+		for( auto it = ls->begin(); it != ls->end(); it = ls->next(it) )
+		{
+			auto vehicle = static_cast<GC_Vehicle*>(ls->at(it));
+			if( (vehicle->GetPos() - center).sqr() < radius * radius )
+				result.push_back(vehicle);
+		}
+	}
+}
+
+void World::AlertSensors(int locX, int locY)
+{
+	ObjectList &sensors = grid_sensors.element(locX, locY);
+	for( auto it = sensors.begin(); it != sensors.end(); it = sensors.next(it) )
+		static_cast<GC_Turret*>(sensors.at(it))->Alert();
+}
+
 IMPLEMENT_POOLED_ALLOCATION(ResumableObject);
 
 ResumableObject* World::Timeout(GC_Object &obj, float timeout)
@@ -452,6 +559,8 @@ void World::Step(float dt)
 			ls->OnGameStarted();
 	}
 
+	_traceCache->NextStep();
+
 	float nextTime = _time + dt;
 	while (!_resumables.empty() && _resumables.top().time < nextTime)
 	{
@@ -4,23 +4,22 @@
 #include <algorithm>
 #include <cstdlib>
 #include <memory>
+#include <vector>
 
 class FieldCell final
 {
 public:
-	static unsigned int _sessionId;
 	unsigned int _mySession = 0xffffffff;
 	//-----------------------------
-	union X
-	{
-		ObjectList::id_type* _objects;
-		ObjectList::id_type _singleObject; // when _objCount==1
-
-		X() {}
-	} _storage;
+	static constexpr unsigned int INLINE_CAPACITY = 4;
+	ObjectList::id_type _inlineObjects[INLINE_CAPACITY];
+	std::unique_ptr<std::vector<ObjectList::id_type>> _overflowObjects; // objects beyond the inline capacity
 	unsigned int _objCount = 0;
+	uint16_t _obstacleRefs[8] = {}; // number of objects per obstacle bit
 	//-----------------------------
-	void UpdateProperties(const World &world);
+	void UpdateProperties();
+	void AddObstacleRefs(uint8_t obstacleFlags);
+	void RemoveObstacleRefs(uint8_t obstacleFlags);
 
 	int _before; // actual path cost to this node
 
@@ -36,11 +35,12 @@ public:
 	unsigned int GetObjectsCount() const { return _objCount; }
 	ObjectList::id_type GetObject(unsigned int index) const
 	{
-		return _objCount > 1 ? _storage._objects[index] : _storage._singleObject;
+		assert(index < _objCount);
+		return index < INLINE_CAPACITY ? _inlineObjects[index] : (*_overflowObjects)[index - INLINE_CAPACITY];
 	}
 
-	bool IsChecked() const { return _mySession == _sessionId; }
-	void Check()           { _mySession = _sessionId;         }
+	bool IsChecked(unsigned int session) const { return _mySession == session; }
+	void Check(unsigned int session)           { _mySession = session;         }
 
 	void AddObject(const World& world, ObjectList::id_type object);
 	void RemoveObject(const World& world, ObjectList::id_type object);
@@ -65,16 +65,33 @@ struct RefFieldCell
 	}
 };
 
+class FieldClusters;
+class FlowFieldCache;
 class GC_RigidBodyStatic;
 
 class Field final
 {
 public:
-	static void NewSession() { ++FieldCell::_sessionId; }
+	// relative path cost of straight and diagonal steps between adjacent cells
+	static constexpr int STEP_COST = 985;
+	static constexpr int STEP_COST_DIAG = 1393;
+
+	Field();
+	~Field();
+
+	// starts a search over the cells of this field; cells checked before are unchecked again
+	unsigned int NewSession() { return ++_sessionId; }
 
 	void Resize(int width, int height);
 	void ProcessObject(const World& world, GC_RigidBodyStatic *object, bool add);
 
+	// Updates the cells of an object moved from 'oldPos'; nothing is touched
+	// while the object stays within the same cells
+	void MoveObject(const World& world, GC_RigidBodyStatic *object, vec2d oldPos);
+
+	// Fills an empty field with all obstacles of the world at once
+	void Build(const World& world);
+
 	const FieldCell& operator() (int x, int y) const
 	{
 		assert(x >= 0 && x < _width && y >= 0 && y < _height);
@@ -86,8 +103,29 @@ public:
 		return const_cast<FieldCell&>(static_cast<const Field*>(this)->operator()(x, y));
 	}
 
+	// search scratch for cells linked to ones further than a step away;
+	// valid for the cells checked during the current session only
+	RefFieldCell& Parent(RefFieldCell cell)
+	{
+		assert(cell.x >= 0 && cell.x < _width && cell.y >= 0 && cell.y < _height);
+		return _parents[cell.x + cell.y * _width];
+	}
+
+	FieldClusters& GetClusters() { return *_clusters; }
+	FlowFieldCache& GetFlowFields() { return *_flowFields; }
+
+	// notifies path planning caches about changed cells in the inclusive range
+	void InvalidateCells(int left, int top, int right, int bottom);
+
 private:
 	std::unique_ptr<FieldCell[]> _cells;
+	std::unique_ptr<RefFieldCell[]> _parents;
+	std::unique_ptr<FieldClusters> _clusters;
+	std::unique_ptr<FlowFieldCache> _flowFields;
+	static RectRB GetObjectCells(const World& world, vec2d pos, float radius);
+	void ProcessCells(const World& world, GC_RigidBodyStatic *object, RectRB cells, bool add);
+
 	int _width = 0;
 	int _height = 0;
+	unsigned int _sessionId = 0;
 };
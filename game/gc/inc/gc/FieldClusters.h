@@ -0,0 +1,95 @@
+#pragma once
+#include "Field.h"
+#include <math/MyMath.h>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Cluster level abstraction of the field used to plan long paths (HPA*).
+// The field is split into square clusters connected through entrances on their
+// borders. Each passability mode gets its own graph which is built lazily and
+// repaired cluster by cluster after the underlying cells change.
+class FieldClusters final
+{
+public:
+	static constexpr int CLUSTER_SIZE = 8;
+
+	FieldClusters(int fieldWidth, int fieldHeight);
+	~FieldClusters();
+
+	// marks clusters overlapping the inclusive cell range for repair
+	void Invalidate(int left, int top, int right, int bottom);
+
+	// inclusive range of cells covered by the cluster containing the cell
+	RectRB GetClusterCells(RefFieldCell cell) const;
+
+	// number of clusters between two cells along the longest axis
+	static int GetClusterDistance(RefFieldCell a, RefFieldCell b);
+
+	//-------------------------------------------------------------------------
+	// Plans a path on the abstract graph.
+	//  passabilityMask    - obstacle bits that block the way
+	//  distanceMultiplier - cost multiplier of passable cells with obstacles
+	//  maxCost            - search depth limit in relative path cost units
+	//  waypoints          - receives cells from start to end; every two
+	//                       consecutive cells share a cluster or are adjacent
+	// Return: false if the end was not reached within maxCost
+	//-------------------------------------------------------------------------
+	bool FindAbstractPath(const Field &field, RefFieldCell start, RefFieldCell end,
+		uint8_t passabilityMask, int distanceMultiplier, int maxCost, std::vector<RefFieldCell> &waypoints);
+
+private:
+	struct Edge
+	{
+		uint16_t node;
+		int cost;
+	};
+
+	struct Node
+	{
+		RefFieldCell cellRef;
+		uint8_t side;      // cluster side the entrance is on: 0 - right, 1 - bottom, 2 - left, 3 - top
+		uint16_t entrance; // entrance index on that side
+		std::vector<Edge> edges; // paths to other nodes of the same cluster
+
+		// search state
+		unsigned int session = 0;
+		int before = 0;
+		int prevCluster = -1;
+		uint16_t prevNode = 0;
+	};
+
+	struct Cluster
+	{
+		std::vector<Node> nodes;
+		uint16_t sideBegin[5] = {}; // nodes of side i are in range [sideBegin[i], sideBegin[i + 1])
+		unsigned int revision = 0xffffffff; // cells revision the nodes were built from
+	};
+
+	struct Layer
+	{
+		uint8_t passabilityMask;
+		int distanceMultiplier;
+		unsigned int revision = 0; // total revision the layer was last repaired at
+		std::vector<Cluster> clusters;
+	};
+
+	int _fieldWidth;
+	int _fieldHeight;
+	int _width;  // in clusters
+	int _height; // in clusters
+
+	std::vector<unsigned int> _revisions; // per cluster
+	unsigned int _totalRevision = 1;
+	unsigned int _session = 0;
+	std::vector<std::unique_ptr<Layer>> _layers;
+
+	Layer& GetLayer(uint8_t passabilityMask, int distanceMultiplier);
+	void Repair(const Field &field, Layer &layer);
+	void BuildNodes(const Field &field, const Layer &layer, int clusterIndex, Cluster &cluster) const;
+	void BuildEdges(const Field &field, const Layer &layer, int clusterIndex, Cluster &cluster) const;
+	void ComputeLocalCosts(const Field &field, const Layer &layer, int clusterIndex, RefFieldCell origin, bool reverse, int *costs) const;
+	int GetStepCost(const Field &field, const Layer &layer, RefFieldCell to, int dx, int dy) const;
+	RectRB GetClusterRect(int clusterIndex) const;
+	int GetClusterIndex(RefFieldCell cell) const;
+};
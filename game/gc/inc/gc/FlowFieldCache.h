@@ -0,0 +1,64 @@
+#pragma once
+#include "Field.h"
+#include <math/MyMath.h>
+#include <cstdint>
+#include <list>
+#include <vector>
+
+// Path costs from every reachable cell to a single goal
+class FlowField final
+{
+public:
+	// path cost to the goal or -1 if the cell is not reachable
+	int GetCost(RefFieldCell cell) const { return _costs[cell.x + cell.y * _width]; }
+
+	// appends cells on the way from start to the goal except the start
+	// Return: false if the goal is not reachable from start
+	bool Trace(const Field &field, RefFieldCell start, std::vector<RefFieldCell> &cells) const;
+
+private:
+	friend class FlowFieldCache;
+
+	RefFieldCell _goal;
+	uint8_t _passabilityMask;
+	int _distanceMultiplier;
+	int _maxCost;
+	int _width = 0;
+	RectRB _reached = {}; // inclusive range of cells with known costs
+	std::vector<int> _costs; // empty until the first computation or after invalidation
+
+	int GetStepCost(const Field &field, RefFieldCell to, int dx, int dy) const;
+	void Compute(const Field &field, int fieldHeight);
+};
+
+// Keeps flow fields for the most recently requested goals so that all vehicles
+// heading to the same destination share a single search. Goals are matched by
+// the exact cell, so it pays off for static goals such as pickups and spawn
+// points; vehicles chasing a moving target rarely request the same cell twice
+// and keep using the regular search.
+class FlowFieldCache final
+{
+public:
+	static constexpr size_t CAPACITY = 16;
+
+	FlowFieldCache(int fieldWidth, int fieldHeight);
+
+	// drops flow fields that may depend on the inclusive cell range
+	void Invalidate(int left, int top, int right, int bottom);
+
+	//-------------------------------------------------------------------------
+	// Looks up a flow field to the goal and computes it once the goal was
+	// requested more than once. Goals requested only once are remembered but
+	// left to the regular search since a flow field costs a full flood fill.
+	//  passabilityMask    - obstacle bits that block the way
+	//  distanceMultiplier - cost multiplier of passable cells with obstacles
+	//  maxCost            - search depth limit in relative path cost units
+	// Return: flow field or nullptr
+	//-------------------------------------------------------------------------
+	const FlowField* Get(const Field &field, RefFieldCell goal, uint8_t passabilityMask, int distanceMultiplier, int maxCost);
+
+private:
+	int _fieldWidth;
+	int _fieldHeight;
+	std::list<FlowField> _entries; // most recently used first
+};
@@ -28,7 +28,7 @@ public:
 	{
 		assert(WIDTH(bounds) > 0 && HEIGHT(bounds) > 0);
 		delete [] _data;
-		_data = new T[WIDTH(bounds) * HEIGHT(bounds)];
+		_data = new T[WIDTH(bounds) * HEIGHT(bounds)]();
 		_bounds = bounds;
 	}
 
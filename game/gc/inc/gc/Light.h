@@ -10,6 +10,7 @@ class GC_Light : public GC_MovingObject
 {
 	DECLARE_SELF_REGISTRATION(GC_Light);
 	DECLARE_LIST_MEMBER(override);
+	DECLARE_GRID_MEMBER();
 
 public:
 	enum enumLightType
@@ -31,29 +32,35 @@ public:
 	void SetAspect(float a) { _aspect = a; }
 	float GetAspect() const { return _aspect; }
 
-	void SetRadius(float r)
+	void SetRadius(World &world, float r)
 	{
+		RemoveRenderRadius(world);
 		if( LIGHT_DIRECT == _type )
 			_offset = r;
 		else
 			_radius = r;
+		AddRenderRadius(world);
 	}
 	void SetLightDirection(const vec2d &d) { _lightDirection = d; }
 	vec2d GetLightDirection() const { return _lightDirection; }
-	void SetOffset(float o)
+	void SetOffset(World &world, float o)
 	{
 		assert(LIGHT_DIRECT != _type);
+		RemoveRenderRadius(world);
 		_offset = o;
+		AddRenderRadius(world);
 	}
 	float GetOffset() const
 	{
 		assert(LIGHT_DIRECT != _type);
 		return _offset;
 	}
-	void SetLength(float l)
+	void SetLength(World &world, float l)
 	{
 		assert(LIGHT_DIRECT == _type);
+		RemoveRenderRadius(world);
 		_radius = l;
+		AddRenderRadius(world);
 	}
 	float GetLength() const
 	{
@@ -86,10 +93,16 @@ public:
 	bool GetActive() const { return CheckFlags(GC_FLAG_LIGHT_ACTIVE); }
 	void SetActive(bool activate);
 
+	// GC_Object
+	void Init(World &world) override;
+	void Kill(World &world) override;
 	void Resume(World &world) override;
 	void Serialize(World &world, SaveFile &f) override;
 
 private:
+	void AddRenderRadius(World &world) const;
+	void RemoveRenderRadius(World &world) const;
+
 	float  _startTime;
 	float  _timeout;
 	float  _aspect;
@@ -51,6 +51,12 @@ public:
 	virtual uint8_t GetObstacleFlags() const = 0;
 	virtual GC_Player* GetOwner() const { return nullptr; }
 
+	// a field cell (in blocks) within the covered range that stays passable
+	virtual bool GetPassableFieldCell(const World &world, int &x, int &y) const { return false; }
+
+	// turns the body and outdates the traces passing through it
+	void SetDirection(World &world, const vec2d &d);
+
 	// GC_MovingObject
 	void MoveTo(World &world, const vec2d &pos) override;
 
@@ -4,7 +4,7 @@
 #include <stack>
 
 #define GC_FLAG_RBDYMAMIC_ACTIVE    (GC_FLAG_RBSTATIC_ << 0)
-#define GC_FLAG_RBDYMAMIC_PARITY    (GC_FLAG_RBSTATIC_ << 1)
+#define GC_FLAG_RBDYMAMIC_PARITY    (GC_FLAG_RBSTATIC_ << 1) // unused, keeps the saved flag layout
 #define GC_FLAG_RBDYMAMIC_          (GC_FLAG_RBSTATIC_ << 2)
 
 
@@ -107,15 +107,12 @@ private:
 	typedef std::vector<Contact> ContactList;
 	static ContactList _contacts;
 	static std::stack<ContactList> _contactsStack;
-	static bool _glob_parity;
 
 	float geta_s(const vec2d &n, const vec2d &c, const GC_RigidBodyStatic *obj) const;
 	float geta_d(const vec2d &n, const vec2d &c, const GC_RigidBodyDynamic *obj) const;
 
 	void impulse(const vec2d &origin, const vec2d &impulse);
 
-	bool parity() { return CheckFlags(GC_FLAG_RBDYMAMIC_PARITY); }
-
 
 	vec2d _external_force;
 	float _external_momentum;
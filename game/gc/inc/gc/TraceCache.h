@@ -0,0 +1,71 @@
+#pragma once
+#include <math/MyMath.h>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+class GC_RigidBodyStatic;
+
+// Remembers results of World::TraceNearest so that observers repeating the
+// same trace every step (turrets, triggers, bots) do not walk the objects
+// again until something changes in the locations the trace passes through.
+class TraceCache final
+{
+public:
+	struct Stats
+	{
+		size_t hits = 0;
+		size_t misses = 0;
+	};
+
+	explicit TraceCache(RectRB locationBounds);
+
+	// marks traces passing through the location as outdated
+	void Invalidate(int locX, int locY);
+
+	// Return: true if the trace was made before and is still valid
+	bool Find(const GC_RigidBodyStatic *ignore, vec2d x0, vec2d a, GC_RigidBodyStatic *&result);
+	void Store(const GC_RigidBodyStatic *ignore, vec2d x0, vec2d a, GC_RigidBodyStatic *result);
+
+	// drops traces which were not requested during the last step
+	void NextStep();
+
+	// counters of the last completed step
+	const Stats& GetStats() const { return _lastStats; }
+
+private:
+	struct Key
+	{
+		const GC_RigidBodyStatic *ignore;
+		vec2d x0;
+		vec2d a;
+
+		bool operator==(const Key &other) const
+		{
+			return ignore == other.ignore && x0 == other.x0 && a == other.a;
+		}
+	};
+
+	struct KeyHash
+	{
+		size_t operator()(const Key &key) const;
+	};
+
+	struct Entry
+	{
+		GC_RigidBodyStatic *result;
+		uint64_t revision;     // the trace is valid while its locations are not changed after this
+		unsigned int step;     // last step the trace was requested at
+	};
+
+	RectRB _bounds;
+	std::vector<uint64_t> _revisions; // per location
+	uint64_t _revision = 0; // wide enough to never wrap
+	unsigned int _step = 0;
+	std::unordered_map<Key, Entry, KeyHash> _entries;
+	Stats _stats;
+	Stats _lastStats;
+
+	bool IsValid(const Key &key, const Entry &entry) const;
+};
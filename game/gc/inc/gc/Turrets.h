@@ -18,6 +18,9 @@ enum TurretState
 #define GC_FLAG_TURRET_FIRE         (GC_FLAG_RBSTATIC_ << 0)
 #define GC_FLAG_TURRET_             (GC_FLAG_RBSTATIC_ << 1)
 
+// first free bit after the saved turret flags; derived turrets define no flags
+#define GC_FLAG_TURRET_ALERT        (GC_FLAG_TURRET_ << 0) // a vehicle may be within sight
+
 class GC_Turret : public GC_RigidBodyStatic
 {
 	DECLARE_LIST_MEMBER(override);
@@ -35,10 +38,15 @@ public:
 	TurretState GetState() const { return _state; }
 
 	virtual float GetReadyState() const { return 1; }
-    virtual void SetInitialDir(float initialDir);
+    virtual void SetInitialDir(World &world, float initialDir);
+
+	// called when a vehicle enters a location within sight
+	void Alert() { SetFlags(GC_FLAG_TURRET_ALERT, true); }
+	bool GetAlert() const { return CheckFlags(GC_FLAG_TURRET_ALERT); }
 
 	// GC_RigidBodyStatic
 	void OnDestroy(World &world, const DamageDesc &dd) override;
+	void MoveTo(World &world, const vec2d &pos) override;
 
 	// GC_Object
 	void Init(World &world) override;
@@ -87,6 +95,10 @@ private:
 	TurretState _state;
 	int      _team;  // 0 - no team
 	float    _sight;
+
+	RectRB GetSensorBounds(const World &world) const;
+	void EnterSensors(World &world);
+	void LeaveSensors(World &world);
 };
 
 /////////////////////////////////////////////////////////////
@@ -160,7 +172,7 @@ public:
 
 	float GetReadyState() const override { return _time_wake / _time_wake_max; }
 
-	void SetInitialDir(float initialDir) override;
+	void SetInitialDir(World &world, float initialDir) override;
 
 	// GC_Object
 	void Serialize(World &world, SaveFile &f) override;
@@ -16,6 +16,7 @@ struct VehicleClass;
 class GC_Vehicle : public GC_RigidBodyDynamic
 {
 	DECLARE_LIST_MEMBER(override);
+	DECLARE_GRID_MEMBER();
 
 public:
 	explicit GC_Vehicle(vec2d pos);
@@ -36,6 +36,7 @@ public:
 	bool IntersectWithRect(const vec2d &rectHalfSize, const vec2d &rectCenter, const vec2d &rectDirection, vec2d &outWhere, vec2d &outNormal, float &outDepth) const override;
 	float GetDefaultHealth() const override { return 50; }
 	uint8_t GetObstacleFlags() const override { return 1; }
+	bool GetPassableFieldCell(const World &world, int &x, int &y) const override;
 
 	// GC_Object
 	void Init(World &world) override;
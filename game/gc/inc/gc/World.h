@@ -3,9 +3,9 @@
 #include "ObjPtr.h"
 #include "WorldEvents.h"
 #include "detail/GlobalListHelper.h"
-#include "detail/JobManager.h"
 #include "detail/MemoryManager.h"
 #include "detail/PtrList.h"
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <queue>
@@ -23,6 +23,8 @@ class SaveFile;
 class GC_Object;
 class GC_Player;
 class GC_RigidBodyStatic;
+class GC_Vehicle;
+class TraceCache;
 
 template<class> struct ObjectListener;
 
@@ -93,16 +95,31 @@ public:
 	PtrList<GC_Object>& GetList(GlobalListID id) { return _objectLists[id]; }
 	const PtrList<GC_Object>& GetList(GlobalListID id) const { return _objectLists[id]; }
 
-	JobManager<GC_Turret> _jobManager;
-
 	Grid<PtrList<GC_Object>>  grid_rigid_s;
 	Grid<PtrList<GC_Object>>  grid_walls;
 	Grid<PtrList<GC_Object>>  grid_pickup;
 	Grid<PtrList<GC_Object>>  grid_moving;
+	Grid<PtrList<GC_Object>>  grid_vehicles;
+	Grid<PtrList<GC_Object>>  grid_sensors; // turrets in every location within their sight
+	Grid<PtrList<GC_Object>>  grid_lights;
+
+	// bumped whenever an object enters or leaves the location in grid_moving,
+	// lets the renderer keep what it found in a location until it changes
+	Grid<unsigned int> grid_moving_revisions;
+
+	// no light reaches farther than this from its position, lets the renderer cull lights by location
+	float _maxLightRenderRadius = 0;
+	std::map<float, unsigned int> _lightRenderRadii; // number of lights per render radius
 
 	std::vector<bool> _waterTiles;
 	std::vector<bool> _woodTiles;
 
+	// for each block, bit i is set when its neighbor at WATER_NEIGHBOR_DX/DY[i] is water;
+	// kept up to date by SetWaterTile so that the terrain does not have to look around every frame
+	std::vector<uint8_t> _waterNeighbors;
+	static const int WATER_NEIGHBOR_DX[8];
+	static const int WATER_NEIGHBOR_DY[8];
+
 	std::string _infoAuthor;
 	std::string _infoEmail;
 	std::string _infoUrl;
@@ -153,10 +170,11 @@ public:
 	                   float projectileSpeed,
 	                   vec2d targetPos,
 	                   vec2d targetVelocity,
-	                   vec2d &out_fake );  // out: fake target position
+	                   vec2d &out_fake ) const;  // out: fake target position
 
 	int GetTileIndex(vec2d pos) const;
 	int GetTileIndex(int blockX, int blockY) const;
+	void SetWaterTile(int tileIndex, bool water);
 
 	//
 	// tracing
@@ -186,6 +204,21 @@ public:
 	template<class SelectorType>
 	void RayTrace(const Grid<PtrList<GC_Object>> &list, SelectorType &s) const;
 
+	// TraceNearest over grid_rigid_s which reuses the result of the same trace
+	// until objects change in the locations along the way. Not thread safe.
+	GC_RigidBodyStatic* TraceNearestCached(const GC_RigidBodyStatic* ignore, const vec2d &x0, const vec2d &a);
+
+	// must be called when a rigid body at the position moves or changes its shape
+	void InvalidateTraces(const vec2d &pos);
+
+	const TraceCache& GetTraceCache() const { return *_traceCache; }
+
+	// appends vehicles with centers closer to the point than the radius
+	void QueryVehicles(const vec2d &center, float radius, std::vector<GC_Vehicle*> &result);
+
+	// wakes up turrets which may see a vehicle in the location
+	void AlertSensors(int locX, int locY);
+
 public:
 	void Clear();
 	GC_Player* GetPlayerByIndex(size_t playerIndex);
@@ -196,6 +229,9 @@ public:
 	const RectRB& GetBlockBounds() const { return _blockBounds; }
 	const FRECT& GetBounds() const { return _bounds; }
 
+	// unique for the process lifetime, tells a world from one created later at the same address
+	unsigned int GetSerial() const { return _serial; }
+
 #ifdef NETWORK_DEBUG
 	uint32_t GetChecksum() const { return _checksum; }
 	unsigned int GetFrame() const { return _frame; }
@@ -205,6 +241,8 @@ public:
 	size_t GetResumableCount() const { return _resumables.size(); }
 
 private:
+	void ImportObjects(MapFile &file);
+
 	struct Resumable
 	{
 		std::unique_ptr<ResumableObject> obj;
@@ -226,6 +264,7 @@ private:
 	FRECT _bounds;
 	RectRB _blockBounds;
 	RectRB _locationBounds;
+	unsigned int _serial;
 
 	friend class GC_Object;
 
@@ -235,5 +274,6 @@ private:
 	std::map<const GC_Object*, std::string_view> _objectToStringMap; // string owned by _nameToObjectMap
 
 	PtrList<GC_Object> _objectLists[GLOBAL_LIST_COUNT];
+	std::unique_ptr<TraceCache> _traceCache;
 };
 
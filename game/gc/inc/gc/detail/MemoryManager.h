@@ -4,6 +4,7 @@
 
 #include <cassert>
 #include <cstring> // memset
+#include <mutex>
 #include <new>
 #include <typeinfo>
 #ifndef NDEBUG
@@ -139,6 +140,9 @@ class MemoryPool final
 	};
 
 
+	// pools are static and shared by all worlds, and maps are imported on loader threads
+	std::mutex _mutex;
+
 	BlockPtr *_blocks;
 	size_t _blockCount;
 	size_t _firstEmptyIdx;
@@ -180,6 +184,8 @@ public:
 
 	void* Alloc()
 	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
 #ifndef NDEBUG
         if( ++_allocatedCount > _allocatedPeak )
             _allocatedPeak = _allocatedCount;
@@ -232,6 +238,8 @@ public:
 
 	void Free(void* p)
 	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
 		assert(_allocatedCount--);
 
 		Block *block = ((BlankObject*) p)->_block;
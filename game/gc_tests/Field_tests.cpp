@@ -0,0 +1,195 @@
+#include <fsmem/FileSystemMemory.h>
+#include <gc/Field.h>
+#include <gc/FieldClusters.h>
+#include <gc/FlowFieldCache.h>
+#include <gc/Wall.h>
+#include <gc/World.h>
+#include <gc/WorldCfg.h>
+#include <gtest/gtest.h>
+#include <MapFile.h>
+#include <climits>
+
+static vec2d BlockCenter(int x, int y)
+{
+	return vec2d{ (float)x, (float)y } * WORLD_BLOCK_SIZE + vec2d{ WORLD_BLOCK_SIZE / 2, WORLD_BLOCK_SIZE / 2 };
+}
+
+TEST(Field, ImportBuildsSameFieldAsInit)
+{
+	RectRB bounds = { 0, 0, 8, 8 };
+	World source(bounds, true /*initField*/);
+	for (int i = 0; i < 8; i++)
+	{
+		source.New<GC_Wall>(BlockCenter(i, 3));
+		source.New<GC_Wall_Concrete>(BlockCenter(3, i));
+	}
+	source.New<GC_Wall>(BlockCenter(0, 0)).SetCorner(source, 3);
+	source.New<GC_Wall>(BlockCenter(6, 6)).SetCorner(source, 1);
+	source.New<GC_Wall>(BlockCenter(7, 7)).SetCorner(source, 2);
+
+	FS::MemoryStream stream;
+	source.Export(stream);
+	stream.Seek(0, SEEK_SET);
+
+	World imported(bounds, true /*initField*/);
+	MapFile file(stream, false /*write*/);
+	imported.Import(file);
+
+	for (int y = 0; y <= HEIGHT(bounds); y++)
+	{
+		for (int x = 0; x <= WIDTH(bounds); x++)
+		{
+			const FieldCell &expected = (*source._field)(x, y);
+			const FieldCell &actual = (*imported._field)(x, y);
+			EXPECT_EQ(expected.ObstacleFlags(), actual.ObstacleFlags()) << x << "," << y;
+			EXPECT_EQ(expected.GetObjectsCount(), actual.GetObjectsCount()) << x << "," << y;
+		}
+	}
+}
+
+TEST(Field, CellTracksObstacleFlagsOfOverlappingObjects)
+{
+	World world({ 0, 0, 8, 8 }, true /*initField*/);
+	vec2d pos = BlockCenter(4, 4);
+
+	std::vector<GC_Wall*> walls;
+	for (int i = 0; i < 6; i++)
+		walls.push_back(&world.New<GC_Wall>(pos));
+	auto &concrete = world.New<GC_Wall_Concrete>(pos);
+
+	const FieldCell &cell = (*world._field)(4, 4);
+	EXPECT_EQ(7u, cell.GetObjectsCount());
+	EXPECT_EQ(0x81, cell.ObstacleFlags());
+
+	concrete.Kill(world);
+	EXPECT_EQ(6u, cell.GetObjectsCount());
+	EXPECT_EQ(0x01, cell.ObstacleFlags());
+
+	ObjectList::id_type last = walls.back()->GetId();
+	walls[1]->Kill(world);
+	walls[2]->Kill(world);
+	EXPECT_EQ(4u, cell.GetObjectsCount());
+	EXPECT_EQ(walls[0]->GetId(), cell.GetObject(0));
+	EXPECT_EQ(last, cell.GetObject(3));
+
+	walls[0]->Kill(world);
+	walls[3]->Kill(world);
+	walls[4]->Kill(world);
+	walls[5]->Kill(world);
+	EXPECT_EQ(0u, cell.GetObjectsCount());
+	EXPECT_EQ(0, cell.ObstacleFlags());
+}
+
+TEST(Field, CellCountsManyOverlappingObstacles)
+{
+	World world({ 0, 0, 8, 8 }, true /*initField*/);
+	vec2d pos = BlockCenter(4, 4);
+
+	std::vector<GC_Wall*> walls;
+	for (int i = 0; i < 300; i++)
+		walls.push_back(&world.New<GC_Wall>(pos));
+
+	const FieldCell &cell = (*world._field)(4, 4);
+	for (int i = 0; i < 299; i++)
+		walls[i]->Kill(world);
+	EXPECT_EQ(0x01, cell.ObstacleFlags());
+
+	walls.back()->Kill(world);
+	EXPECT_EQ(0, cell.ObstacleFlags());
+}
+
+TEST(Field, MovedObstacleLeavesOldCells)
+{
+	World world({ 0, 0, 8, 8 }, true /*initField*/);
+	auto &wall = world.New<GC_Wall>(BlockCenter(2, 2));
+	const Field &field = *world._field;
+	ASSERT_EQ(1u, field(2, 2).GetObjectsCount());
+	ASSERT_EQ(1u, field(3, 3).GetObjectsCount());
+
+	// small moves keep the object in the same cells
+	wall.MoveTo(world, BlockCenter(2, 2) + vec2d{ 3, 3 });
+	EXPECT_EQ(1u, field(2, 2).GetObjectsCount());
+	EXPECT_EQ(1u, field(3, 3).GetObjectsCount());
+	EXPECT_EQ(0x01, field(3, 3).ObstacleFlags());
+
+	wall.MoveTo(world, BlockCenter(5, 5));
+	EXPECT_EQ(0u, field(2, 2).GetObjectsCount());
+	EXPECT_EQ(0u, field(3, 3).GetObjectsCount());
+	EXPECT_EQ(0, field(3, 3).ObstacleFlags());
+	EXPECT_EQ(1u, field(5, 5).GetObjectsCount());
+	EXPECT_EQ(1u, field(6, 6).GetObjectsCount());
+	EXPECT_EQ(0x01, field(6, 6).ObstacleFlags());
+}
+
+TEST(Field, ClustersFollowDestroyedWalls)
+{
+	World world({ 0, 0, 32, 16 }, true /*initField*/);
+
+	// concrete barrier with a gap closed by two brick walls
+	std::vector<GC_Wall*> walls;
+	for (int y = 0; y < 16; y++)
+	{
+		if (y == 8 || y == 9)
+			walls.push_back(&world.New<GC_Wall>(BlockCenter(12, y)));
+		else
+			world.New<GC_Wall_Concrete>(BlockCenter(12, y));
+	}
+
+	FieldClusters &clusters = world._field->GetClusters();
+	RefFieldCell start = { 4, 4 };
+	RefFieldCell end = { 28, 4 };
+	std::vector<RefFieldCell> waypoints;
+
+	EXPECT_FALSE(clusters.FindAbstractPath(*world._field, start, end, 0xFF, 1, INT_MAX, waypoints));
+	EXPECT_TRUE(clusters.FindAbstractPath(*world._field, start, end, 0xFE, 4, INT_MAX, waypoints));
+
+	for (auto wall: walls)
+		wall->Kill(world);
+
+	ASSERT_TRUE(clusters.FindAbstractPath(*world._field, start, end, 0xFF, 1, INT_MAX, waypoints));
+	ASSERT_GE(waypoints.size(), 2u);
+	EXPECT_EQ(start, waypoints.front());
+	EXPECT_EQ(end, waypoints.back());
+	for (size_t i = 1; i < waypoints.size(); i++)
+	{
+		RectRB cluster = clusters.GetClusterCells(waypoints[i - 1]);
+		bool sameCluster = waypoints[i].x >= cluster.left && waypoints[i].x <= cluster.right &&
+			waypoints[i].y >= cluster.top && waypoints[i].y <= cluster.bottom;
+		bool adjacent = std::abs(waypoints[i].x - waypoints[i - 1].x) + std::abs(waypoints[i].y - waypoints[i - 1].y) == 1;
+		EXPECT_TRUE(sameCluster || adjacent) << i;
+		EXPECT_EQ(0, (*world._field)(waypoints[i].x, waypoints[i].y).ObstacleFlags()) << i;
+	}
+
+	EXPECT_FALSE(clusters.FindAbstractPath(*world._field, start, end, 0xFF, 1, Field::STEP_COST * 10, waypoints));
+}
+
+TEST(Field, FlowFieldIsSharedUntilObstaclesChange)
+{
+	World world({ 0, 0, 16, 16 }, true /*initField*/);
+	auto &wall = world.New<GC_Wall>(BlockCenter(7, 4));
+
+	FlowFieldCache &flows = world._field->GetFlowFields();
+	RefFieldCell goal = { 12, 5 };
+
+	// the first request only registers the goal
+	EXPECT_EQ(nullptr, flows.Get(*world._field, goal, 0xFF, 1, INT_MAX));
+	const FlowField *flow = flows.Get(*world._field, goal, 0xFF, 1, INT_MAX);
+	ASSERT_NE(nullptr, flow);
+	EXPECT_EQ(flow, flows.Get(*world._field, goal, 0xFF, 1, INT_MAX));
+	EXPECT_EQ(0, flow->GetCost(goal));
+	EXPECT_EQ(-1, flow->GetCost({ 7, 5 }));
+
+	std::vector<RefFieldCell> cells;
+	ASSERT_TRUE(flow->Trace(*world._field, { 2, 5 }, cells));
+	ASSERT_FALSE(cells.empty());
+	EXPECT_EQ(goal, cells.back());
+	for (auto cell: cells)
+		EXPECT_EQ(0, (*world._field)(cell.x, cell.y).ObstacleFlags());
+	int detourCost = flow->GetCost({ 2, 5 });
+	EXPECT_GT(detourCost, 10 * Field::STEP_COST);
+
+	wall.Kill(world);
+	flow = flows.Get(*world._field, goal, 0xFF, 1, INT_MAX);
+	ASSERT_NE(nullptr, flow);
+	EXPECT_EQ(10 * Field::STEP_COST, flow->GetCost({ 2, 5 }));
+}
@@ -0,0 +1,62 @@
+#include <gc/Light.h>
+#include <gc/World.h>
+#include <gc/WorldCfg.h>
+#include <gtest/gtest.h>
+
+static bool InLocation(const World &world, const GC_Light &light, int locX, int locY)
+{
+	auto &cell = world.grid_lights.element(locX, locY);
+	for (auto id = cell.begin(); id != cell.end(); id = cell.next(id))
+	{
+		if (cell.at(id) == &light)
+			return true;
+	}
+	return false;
+}
+
+TEST(Light, GridFollowsLight)
+{
+	World world({ 0, 0, 16, 16 }, false /*initField*/);
+	auto &light = world.New<GC_Light>(vec2d{ 1.5f, 2.5f } * WORLD_LOCATION_SIZE, GC_Light::LIGHT_POINT);
+	EXPECT_TRUE(InLocation(world, light, 1, 2));
+
+	light.MoveTo(world, vec2d{ 3.5f, 0.5f } * WORLD_LOCATION_SIZE);
+	EXPECT_FALSE(InLocation(world, light, 1, 2));
+	EXPECT_TRUE(InLocation(world, light, 3, 0));
+
+	// lights outside of the world stay in the border locations
+	light.MoveTo(world, vec2d{ -10, 0.5f } * WORLD_LOCATION_SIZE);
+	EXPECT_TRUE(InLocation(world, light, 0, 0));
+
+	light.Kill(world);
+	EXPECT_TRUE(world.grid_lights.element(0, 0).empty());
+}
+
+TEST(Light, MaxRenderRadiusCoversAllLights)
+{
+	World world({ 0, 0, 16, 16 }, false /*initField*/);
+	auto &point = world.New<GC_Light>(vec2d{}, GC_Light::LIGHT_POINT);
+	EXPECT_EQ(point.GetRenderRadius(), world._maxLightRenderRadius);
+
+	point.SetRadius(world, 300);
+	EXPECT_EQ(300, world._maxLightRenderRadius);
+
+	auto &spot = world.New<GC_Light>(vec2d{}, GC_Light::LIGHT_SPOT);
+	spot.SetRadius(world, 200);
+	spot.SetOffset(world, 170);
+	EXPECT_EQ(370, world._maxLightRenderRadius);
+
+	auto &direct = world.New<GC_Light>(vec2d{}, GC_Light::LIGHT_DIRECT);
+	direct.SetLength(world, 1000);
+	EXPECT_EQ(1000, world._maxLightRenderRadius);
+
+	direct.SetLength(world, 0);
+	EXPECT_EQ(370, world._maxLightRenderRadius);
+
+	direct.Kill(world);
+	spot.Kill(world);
+	EXPECT_EQ(300, world._maxLightRenderRadius);
+
+	point.Kill(world);
+	EXPECT_EQ(0, world._maxLightRenderRadius);
+}
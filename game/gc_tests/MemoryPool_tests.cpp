@@ -0,0 +1,35 @@
+#include <gc/detail/MemoryManager.h>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+TEST(MemoryPool, AllocFreeFromSeveralThreads)
+{
+	struct Item { int value[8]; };
+	MemoryPool<Item> pool;
+
+	auto worker = [&pool](int seed)
+	{
+		std::vector<Item*> items;
+		for (int round = 0; round < 50; round++)
+		{
+			for (int i = 0; i < 300; i++)
+			{
+				items.push_back(static_cast<Item*>(pool.Alloc()));
+				items.back()->value[0] = seed + i;
+			}
+			for (int i = 0; i < 300; i++)
+			{
+				EXPECT_EQ(seed + i, items[i]->value[0]);
+				pool.Free(items[i]);
+			}
+			items.clear();
+		}
+	};
+
+	std::vector<std::thread> threads;
+	for (int t = 0; t < 4; t++)
+		threads.emplace_back(worker, t * 1000);
+	for (auto &thread: threads)
+		thread.join();
+}
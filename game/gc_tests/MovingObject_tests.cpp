@@ -0,0 +1,38 @@
+#include <gc/Light.h>
+#include <gc/World.h>
+#include <gc/WorldCfg.h>
+#include <gtest/gtest.h>
+
+TEST(MovingObject, GridRevisionChangesWithLocationContents)
+{
+	World world({ 0, 0, 16, 16 }, false /*initField*/);
+	unsigned int from = world.grid_moving_revisions.element(1, 2);
+	unsigned int to = world.grid_moving_revisions.element(3, 0);
+
+	auto &light = world.New<GC_Light>(vec2d{ 1.5f, 2.5f } * WORLD_LOCATION_SIZE, GC_Light::LIGHT_POINT);
+	EXPECT_NE(from, world.grid_moving_revisions.element(1, 2));
+	from = world.grid_moving_revisions.element(1, 2);
+
+	// moving within the location does not change what it contains
+	light.MoveTo(world, vec2d{ 1.7f, 2.2f } * WORLD_LOCATION_SIZE);
+	EXPECT_EQ(from, world.grid_moving_revisions.element(1, 2));
+
+	light.MoveTo(world, vec2d{ 3.5f, 0.5f } * WORLD_LOCATION_SIZE);
+	EXPECT_NE(from, world.grid_moving_revisions.element(1, 2));
+	EXPECT_NE(to, world.grid_moving_revisions.element(3, 0));
+	to = world.grid_moving_revisions.element(3, 0);
+
+	light.Kill(world);
+	EXPECT_NE(to, world.grid_moving_revisions.element(3, 0));
+}
+
+TEST(MovingObject, WorldSerialIsUnique)
+{
+	unsigned int serial;
+	{
+		World world({ 0, 0, 1, 1 }, false /*initField*/);
+		serial = world.GetSerial();
+	}
+	World world({ 0, 0, 1, 1 }, false /*initField*/);
+	EXPECT_NE(serial, world.GetSerial());
+}
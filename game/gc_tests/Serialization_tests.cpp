@@ -3,6 +3,7 @@
 #include <gc/SaveFile.h>
 #include <gc/World.h>
 #include <gtest/gtest.h>
+#include <MapFile.h>
 
 TEST(Serialization, CanSerializeEmptyWorld)
 {
@@ -48,3 +49,111 @@ TEST(Serialization, CanSerializeNamedObject)
 
 
 
+
+TEST(Serialization, CanImportExportedMap)
+{
+	FS::MemoryStream stream;
+	{
+		World world({ 0, 0, 16, 16 }, false /*initField*/);
+		world.New<GC_SpawnPoint>(vec2d{ 10, 20 }).SetName(world, "first");
+		world.New<GC_SpawnPoint>(vec2d{ 30, 40 }).SetName(world, "second");
+		world.New<GC_SpawnPoint>(vec2d{ 50, 60 }).SetName(world, "third");
+		world.Export(stream);
+	}
+
+	stream.Seek(0, SEEK_SET);
+	{
+		World world({ 0, 0, 16, 16 }, false /*initField*/);
+		MapFile file(stream, false /*write*/);
+		world.Import(file);
+
+		auto first = dynamic_cast<GC_SpawnPoint*>(world.FindObject("first"));
+		auto second = dynamic_cast<GC_SpawnPoint*>(world.FindObject("second"));
+		auto third = dynamic_cast<GC_SpawnPoint*>(world.FindObject("third"));
+		ASSERT_TRUE(first != nullptr);
+		ASSERT_TRUE(second != nullptr);
+		ASSERT_TRUE(third != nullptr);
+		EXPECT_EQ((vec2d{ 10, 20 }), first->GetPos());
+		EXPECT_EQ((vec2d{ 30, 40 }), second->GetPos());
+		EXPECT_EQ((vec2d{ 50, 60 }), third->GetPos());
+	}
+}
+
+static void WriteThings(FS::Stream &stream)
+{
+	MapFile file(stream, true /*write*/);
+	for (int i = 0; i < 3; i++)
+	{
+		file.BeginObject("thing");
+		file.setObjectAttribute("count", i);
+		file.setObjectAttribute("scale", (float)i / 2);
+		file.setObjectAttribute("label", std::to_string(i));
+		file.WriteCurrentObject();
+	}
+	file.WriteEndOfFile();
+}
+
+TEST(Serialization, MapObjectAttributesInAnyOrder)
+{
+	FS::MemoryStream stream;
+	WriteThings(stream);
+
+	stream.Seek(0, SEEK_SET);
+	MapFile file(stream, false /*write*/);
+	int orders[3][3] = { { 0, 1, 2 }, { 2, 0, 1 }, { 1, 2, 0 } };
+	for (auto &order: orders)
+	{
+		ASSERT_TRUE(file.ReadNextObject());
+		for (int attr: order)
+		{
+			int count = -1;
+			float scale = -1;
+			std::string label;
+			switch (attr)
+			{
+			case 0:
+				EXPECT_TRUE(file.getObjectAttribute("count", count));
+				EXPECT_EQ(&order - orders, count);
+				break;
+			case 1:
+				EXPECT_TRUE(file.getObjectAttribute("scale", scale));
+				EXPECT_EQ((float)(&order - orders) / 2, scale);
+				break;
+			case 2:
+				EXPECT_TRUE(file.getObjectAttribute("label", label));
+				EXPECT_EQ(std::to_string(&order - orders), label);
+				break;
+			}
+		}
+	}
+	EXPECT_FALSE(file.ReadNextObject());
+}
+
+TEST(Serialization, MapObjectAttributeOfOtherTypeIsMissing)
+{
+	FS::MemoryStream stream;
+	WriteThings(stream);
+
+	stream.Seek(0, SEEK_SET);
+	MapFile file(stream, false /*write*/);
+	for (int i = 0; i < 3; i++)
+	{
+		ASSERT_TRUE(file.ReadNextObject());
+
+		// the same query order each time, so the mismatch also goes through the cached slot
+		float count = -1;
+		EXPECT_FALSE(file.getObjectAttribute("count", count));
+		EXPECT_EQ(-1, count);
+
+		int scale = -1;
+		EXPECT_FALSE(file.getObjectAttribute("scale", scale));
+		EXPECT_EQ(-1, scale);
+
+		std::string label;
+		EXPECT_TRUE(file.getObjectAttribute("label", label));
+		EXPECT_EQ(std::to_string(i), label);
+
+		int missing = -1;
+		EXPECT_FALSE(file.getObjectAttribute("missing", missing));
+	}
+}
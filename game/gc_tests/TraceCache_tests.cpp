@@ -0,0 +1,46 @@
+#include <gc/TraceCache.h>
+#include <gc/Vehicle.h>
+#include <gc/Wall.h>
+#include <gc/World.h>
+#include <gc/WorldCfg.h>
+#include <gtest/gtest.h>
+
+TEST(TraceCache, FollowsObstacleChanges)
+{
+	World world({ 0, 0, 32, 32 }, false /*initField*/);
+	vec2d from = { 2 * WORLD_BLOCK_SIZE, 2 * WORLD_BLOCK_SIZE };
+	vec2d way = { 20 * WORLD_BLOCK_SIZE, 0 };
+	auto &wall = world.New<GC_Wall>(from + vec2d{ 10.5f * WORLD_BLOCK_SIZE, 0 });
+
+	world.Step(0.01f);
+	EXPECT_EQ(&wall, world.TraceNearestCached(nullptr, from, way));
+	EXPECT_EQ(&wall, world.TraceNearestCached(nullptr, from, way));
+
+	// an object far away from the ray keeps the cached result
+	world.New<GC_Wall>(vec2d{ 2 * WORLD_BLOCK_SIZE, 28 * WORLD_BLOCK_SIZE });
+	EXPECT_EQ(&wall, world.TraceNearestCached(nullptr, from, way));
+
+	world.Step(0.01f);
+	EXPECT_EQ(2, world.GetTraceCache().GetStats().hits);
+	EXPECT_EQ(1, world.GetTraceCache().GetStats().misses);
+
+	auto &closer = world.New<GC_Wall>(from + vec2d{ 4.5f * WORLD_BLOCK_SIZE, 0 });
+	EXPECT_EQ(&closer, world.TraceNearestCached(nullptr, from, way));
+
+	closer.MoveTo(world, from + vec2d{ 4.5f * WORLD_BLOCK_SIZE, 6 * WORLD_BLOCK_SIZE });
+	EXPECT_EQ(&wall, world.TraceNearestCached(nullptr, from, way));
+
+	wall.Kill(world);
+	EXPECT_EQ(nullptr, world.TraceNearestCached(nullptr, from, way));
+
+	auto &vehicle = world.New<GC_Tank_Light>(from + vec2d{ 8 * WORLD_BLOCK_SIZE, 8 * WORLD_BLOCK_SIZE });
+	EXPECT_EQ(nullptr, world.TraceNearestCached(nullptr, from, way));
+	vehicle.MoveTo(world, from + vec2d{ 8 * WORLD_BLOCK_SIZE, 0 });
+	EXPECT_EQ(&vehicle, world.TraceNearestCached(nullptr, from, way));
+
+	// a turned square reaches further than its half size
+	auto &turned = world.New<GC_Wall>(from + vec2d{ 4.5f * WORLD_BLOCK_SIZE, 0.6f * WORLD_BLOCK_SIZE });
+	EXPECT_EQ(&vehicle, world.TraceNearestCached(nullptr, from, way));
+	turned.SetDirection(world, Vec2dDirection(PI / 4));
+	EXPECT_EQ(&turned, world.TraceNearestCached(nullptr, from, way));
+}
@@ -0,0 +1,55 @@
+#include <gc/Turrets.h>
+#include <gc/Vehicle.h>
+#include <gc/World.h>
+#include <gc/WorldCfg.h>
+#include <gtest/gtest.h>
+
+TEST(Turret, SleepsUntilVehicleComesNear)
+{
+	World world({ 0, 0, 64, 64 }, false /*initField*/);
+	vec2d pos = { 16 * WORLD_BLOCK_SIZE, 16 * WORLD_BLOCK_SIZE };
+	auto &turret = world.New<GC_TurretCannon>(pos);
+	EXPECT_TRUE(turret.GetAlert());
+
+	world.Step(0.01f);
+	EXPECT_FALSE(turret.GetAlert());
+
+	auto &vehicle = world.New<GC_Tank_Light>(pos + vec2d{ 40 * WORLD_BLOCK_SIZE, 0 });
+	world.Step(0.01f);
+	EXPECT_FALSE(turret.GetAlert());
+
+	vehicle.MoveTo(world, pos + vec2d{ 5 * WORLD_BLOCK_SIZE, 0 });
+	EXPECT_TRUE(turret.GetAlert());
+
+	// vehicles without owners are not targets but keep the turret awake
+	world.Step(0.01f);
+	EXPECT_TRUE(turret.GetAlert());
+	EXPECT_EQ(TS_WAITING, turret.GetState());
+
+	vehicle.MoveTo(world, pos + vec2d{ 40 * WORLD_BLOCK_SIZE, 0 });
+	world.Step(0.01f);
+	EXPECT_FALSE(turret.GetAlert());
+}
+
+TEST(Turret, SensorsFollowMovedTurret)
+{
+	World world({ 0, 0, 64, 64 }, false /*initField*/);
+	vec2d oldPos = { 8 * WORLD_BLOCK_SIZE, 8 * WORLD_BLOCK_SIZE };
+	vec2d newPos = { 48 * WORLD_BLOCK_SIZE, 48 * WORLD_BLOCK_SIZE };
+	auto &turret = world.New<GC_TurretCannon>(oldPos);
+	turret.MoveTo(world, newPos);
+	world.Step(0.01f);
+	EXPECT_FALSE(turret.GetAlert());
+
+	auto &vehicle = world.New<GC_Tank_Light>(oldPos);
+	world.Step(0.01f);
+	EXPECT_FALSE(turret.GetAlert());
+
+	vehicle.MoveTo(world, newPos + vec2d{ 5 * WORLD_BLOCK_SIZE, 0 });
+	EXPECT_TRUE(turret.GetAlert());
+
+	// the sensors at the old position must not refer to the killed turret
+	turret.Kill(world);
+	vehicle.MoveTo(world, oldPos);
+	vehicle.MoveTo(world, newPos);
+}
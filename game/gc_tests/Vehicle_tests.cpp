@@ -0,0 +1,34 @@
+#include <gc/Vehicle.h>
+#include <gc/World.h>
+#include <gc/WorldCfg.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+
+static bool Contains(const std::vector<GC_Vehicle*> &vehicles, const GC_Vehicle &vehicle)
+{
+	return vehicles.end() != std::find(vehicles.begin(), vehicles.end(), &vehicle);
+}
+
+TEST(Vehicle, QueryFollowsMovedAndKilledVehicles)
+{
+	World world({ 0, 0, 64, 64 }, false /*initField*/);
+	vec2d center = { 10 * WORLD_BLOCK_SIZE, 10 * WORLD_BLOCK_SIZE };
+	auto &near = world.New<GC_Tank_Light>(center + vec2d{ 3 * WORLD_BLOCK_SIZE, 0 });
+	auto &far = world.New<GC_Tank_Light>(center + vec2d{ 0, 30 * WORLD_BLOCK_SIZE });
+	auto &doomed = world.New<GC_Tank_Light>(center - vec2d{ 2 * WORLD_BLOCK_SIZE, 2 * WORLD_BLOCK_SIZE });
+
+	std::vector<GC_Vehicle*> found;
+	world.QueryVehicles(center, 5 * WORLD_BLOCK_SIZE, found);
+	EXPECT_EQ(2, found.size());
+	EXPECT_TRUE(Contains(found, near));
+	EXPECT_TRUE(Contains(found, doomed));
+
+	far.MoveTo(world, center + vec2d{ 0, 4 * WORLD_BLOCK_SIZE });
+	near.MoveTo(world, center + vec2d{ 40 * WORLD_BLOCK_SIZE, 0 });
+	doomed.Kill(world);
+
+	found.clear();
+	world.QueryVehicles(center, 5 * WORLD_BLOCK_SIZE, found);
+	ASSERT_EQ(1, found.size());
+	EXPECT_EQ(&far, found[0]);
+}
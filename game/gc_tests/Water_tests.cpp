@@ -0,0 +1,77 @@
+#include <gc/Water.h>
+#include <gc/World.h>
+#include <gc/WorldCfg.h>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+static int CountWaterNeighbors(const World &world, int x0, int y0)
+{
+	int neighbors = 0;
+	for (int i = 0; i < 8; i++)
+	{
+		int tileIndex = world.GetTileIndex(x0 + World::WATER_NEIGHBOR_DX[i], y0 + World::WATER_NEIGHBOR_DY[i]);
+		if (tileIndex != -1 && world._waterTiles[tileIndex])
+			neighbors |= 1 << i;
+	}
+	return neighbors;
+}
+
+static vec2d BlockCenter(int x, int y)
+{
+	return vec2d{ x + 0.5f, y + 0.5f } * WORLD_BLOCK_SIZE;
+}
+
+TEST(Water, NeighborsFollowWaterChanges)
+{
+	World world({ -3, -2, 13, 10 }, false /*initField*/);
+	std::mt19937 random(1);
+	std::vector<GC_Water*> water;
+	for (int step = 0; step < 300; step++)
+	{
+		int x = world.GetBlockBounds().left + (int)(random() % WIDTH(world.GetBlockBounds()));
+		int y = world.GetBlockBounds().top + (int)(random() % HEIGHT(world.GetBlockBounds()));
+		int tileIndex = world.GetTileIndex(x, y);
+		if (!world._waterTiles[tileIndex])
+		{
+			water.push_back(&world.New<GC_Water>(BlockCenter(x, y)));
+		}
+		else if (random() % 2)
+		{
+			for (auto it = water.begin(); it != water.end(); ++it)
+			{
+				if (world.GetTileIndex((*it)->GetPos()) == tileIndex)
+				{
+					(*it)->Kill(world);
+					water.erase(it);
+					break;
+				}
+			}
+		}
+		else
+		{
+			// move somewhere free, possibly outside of the world
+			int tx = x + (int)(random() % 5) - 2;
+			int ty = y + (int)(random() % 5) - 2;
+			int targetIndex = world.GetTileIndex(tx, ty);
+			if (targetIndex == -1 || !world._waterTiles[targetIndex])
+			{
+				for (auto w: water)
+				{
+					if (world.GetTileIndex(w->GetPos()) == tileIndex)
+					{
+						w->MoveTo(world, BlockCenter(tx, ty));
+						break;
+					}
+				}
+			}
+		}
+
+		for (int by = world.GetBlockBounds().top; by < world.GetBlockBounds().bottom; by++)
+		for (int bx = world.GetBlockBounds().left; bx < world.GetBlockBounds().right; bx++)
+		{
+			ASSERT_EQ(CountWaterNeighbors(world, bx, by), world._waterNeighbors[world.GetTileIndex(bx, by)])
+				<< "step " << step << " block " << bx << "," << by;
+		}
+	}
+}
@@ -7,6 +7,7 @@
 #include <gc/World.h>
 #include <render/WorldView.h>
 #include <video/RenderContext.h>
+#include <algorithm>
 #include <cassert>
 
 
@@ -64,6 +65,7 @@ GameViewHarness::GameViewHarness(World &world, WorldController &worldController)
 		vec2d pos = player->GetVehicle() ? player->GetVehicle()->GetPos() : Center(_world.GetBounds());
 		_cameras.emplace_back(pos, *player);
 	}
+	_worldViewCaches.resize(std::max<size_t>(_cameras.size(), 1));
 }
 
 GameViewHarness::~GameViewHarness()
@@ -128,17 +130,18 @@ void GameViewHarness::RenderGame(RenderContext &rc, const WorldView &worldView,
 			vec2d eye = GetMaxShakeCamera().GetCameraPos();
 			rc.PushClippingRect(GetMaxShakeCamera().GetViewport());
 			rc.PushWorldTransform(ComputeWorldTransformOffset(RectToFRect(GetMaxShakeCamera().GetViewport()), eye, _scale), _scale, 1);
-			worldView.Render(rc, _world, options, aiManager);
+			worldView.Render(rc, _world, options, aiManager, &_worldViewCaches[0]);
 			rc.PopTransform();
 			rc.PopClippingRect();
 		}
 		else
-		for( auto &camera: _cameras )
+		for( size_t camIndex = 0; camIndex != _cameras.size(); ++camIndex )
 		{
+			const Camera &camera = _cameras[camIndex];
 			vec2d eye = camera.GetCameraPos();
 			rc.PushClippingRect(camera.GetViewport());
 			rc.PushWorldTransform(ComputeWorldTransformOffset(RectToFRect(camera.GetViewport()), eye, _scale), _scale, 1);
-			worldView.Render(rc, _world, options, aiManager);
+			worldView.Render(rc, _world, options, aiManager, &_worldViewCaches[camIndex]);
 			rc.PopTransform();
 			rc.PopClippingRect();
 		}
@@ -151,7 +154,7 @@ void GameViewHarness::RenderGame(RenderContext &rc, const WorldView &worldView,
 		RectRB viewport{ 0, 0, _pxWidth, _pxHeight };
 		rc.PushClippingRect(viewport);
 		rc.PushWorldTransform(ComputeWorldTransformOffset(RectToFRect(viewport), eye, zoom), zoom, 1);
-		worldView.Render(rc, _world, options, aiManager);
+		worldView.Render(rc, _world, options, aiManager, &_worldViewCaches[0]);
 		rc.PopTransform();
 		rc.PopClippingRect();
 	}
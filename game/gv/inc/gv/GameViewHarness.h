@@ -11,6 +11,7 @@ class RenderContext;
 class World;
 class WorldController;
 class WorldView;
+class WorldViewCache;
 
 RectRB GetCameraViewport(int screenW, int screenH, unsigned int camCount, unsigned int camIndex);
 
@@ -39,6 +40,7 @@ public:
 private:
 	World &_world;
 	std::vector<Camera> _cameras;
+	mutable std::vector<WorldViewCache> _worldViewCaches; // one per view
 	int _pxWidth = 0;
 	int _pxHeight = 0;
 	float _scale = 1;
@@ -277,14 +277,38 @@ void MapFile::setMapAttribute(std::string name, std::string value)
 	_mapAttrs.attrs_str[std::move(name)] = std::move(value);
 }
 
-bool MapFile::getObjectAttribute(std::string_view name, int &value) const
+const MapFile::ObjectDefinition::Property* MapFile::FindObjectProperty(std::string_view name, enumDataTypes type) const
 {
 	assert(!_modeWrite);
-	auto &pd = _managed_classes[_objType].propertyDefinitions;
-	auto it = std::find_if(begin(pd), end(pd), [&](auto &p) { return p.name == name; });
-	if (it != pd.end())
+	assert(_objType >= 0 && _objType < (int) _managed_classes.size());
+	const ObjectDefinition &od = _managed_classes[_objType];
+
+	size_t slot = _nextSlot++;
+	if( slot < od.slots.size() && od.slots[slot].type == type && od.slots[slot].name == name )
 	{
-		value = it->value_int;
+		int index = od.slots[slot].index;
+		return index >= 0 ? &od.propertyDefinitions[index] : nullptr;
+	}
+
+	// first object of this class or the query order has changed
+	auto &pd = od.propertyDefinitions;
+	auto it = std::find_if(begin(pd), end(pd), [&](auto &p) { return p._type == type && p.name == name; });
+	int index = it != pd.end() ? static_cast<int>(it - pd.begin()) : -1;
+
+	ObjectDefinition::Slot resolved = { std::string(name), type, index };
+	if( slot < od.slots.size() )
+		od.slots[slot] = std::move(resolved);
+	else
+		od.slots.push_back(std::move(resolved));
+
+	return index >= 0 ? &pd[index] : nullptr;
+}
+
+bool MapFile::getObjectAttribute(std::string_view name, int &value) const
+{
+	if (auto prop = FindObjectProperty(name, DATATYPE_INT))
+	{
+		value = prop->value_int;
 		return true;
 	}
 	return false;
@@ -292,12 +316,9 @@ bool MapFile::getObjectAttribute(std::string_view name, int &value) const
 
 bool MapFile::getObjectAttribute(std::string_view name, float &value) const
 {
-	assert(!_modeWrite);
-	auto &pd = _managed_classes[_objType].propertyDefinitions;
-	auto it = std::find_if(begin(pd), end(pd), [&](auto &p) { return p.name == name; });
-	if (it != pd.end())
+	if (auto prop = FindObjectProperty(name, DATATYPE_FLOAT))
 	{
-		value = it->value_float;
+		value = prop->value_float;
 		return true;
 	}
 	return false;
@@ -305,12 +326,9 @@ bool MapFile::getObjectAttribute(std::string_view name, float &value) const
 
 bool MapFile::getObjectAttribute(std::string_view name, std::string &value) const
 {
-	assert(!_modeWrite);
-	auto &pd = _managed_classes[_objType].propertyDefinitions;
-	auto it = std::find_if(begin(pd), end(pd), [&](auto &p) { return p.name == name; });
-	if (it != pd.end())
+	if (auto prop = FindObjectProperty(name, DATATYPE_STRING))
 	{
-		value = it->value_string;
+		value = prop->value_string;
 		return true;
 	}
 	return false;
@@ -490,6 +508,7 @@ bool MapFile::ReadNextObject()
 				ReadInt(_objType);
 				if( _objType < 0 || _objType >= (int) _managed_classes.size() )
 					throw std::runtime_error("invalid class");
+				_nextSlot = 0;
 
 				for( auto &prop: _managed_classes[_objType].propertyDefinitions )
 				{
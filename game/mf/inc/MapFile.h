@@ -164,8 +164,18 @@ class MapFile
 			};
 		};
 
+		// Objects of one class query their attributes in the same order, so the n-th
+		// getObjectAttribute call is resolved to a property index once and reused.
+		struct Slot
+		{
+			std::string   name;
+			enumDataTypes type;
+			int           index; // -1 if the class has no such property
+		};
+
 		std::string           className;
 		std::vector<Property> propertyDefinitions;
+		mutable std::vector<Slot> slots;
 	};
 
 private:
@@ -183,6 +193,9 @@ private:
 
 	int _objType; // index in _managed_classes
 	int _numProperties; // in current object
+	mutable size_t _nextSlot = 0; // in current object
+
+	const ObjectDefinition::Property* FindObjectProperty(std::string_view name, enumDataTypes type) const;
 
 	bool _read_chunk_header(ChunkHeader &chdr);
 	void _skip_block(size_t size);
@@ -4,6 +4,8 @@
 #include <video/RenderBase.h>
 #include <video/TextureManager.h>
 #include <video/RenderContext.h>
+#include <array>
+#include <cstdint>
 
 Terrain::Terrain(TextureManager &tm)
 	: _texBack(tm.FindSprite("background"))
@@ -60,9 +62,22 @@ static constexpr TileRule rules12[] =
 	{ 7, CT },
 	{ 8, LT, CT|LC },
 };
-//                            LT  CT  RT    LC  RC    LB  CB  RB
-static constexpr int dx[8] = {-1,  0,  1,   -1,  1,   -1,  0,  1 };
-static constexpr int dy[8] = {-1, -1, -1,    0,  0,    1,  1,  1 };
+// bit n of s_waterFrames[mask] tells whether rules21[n] applies to a block with the water neighbors mask,
+// evaluated once so that drawing a block takes one lookup instead of matching every rule
+static const auto s_waterFrames = []
+{
+	static_assert(sizeof(rules21) / sizeof(*rules21) <= 32, "rule set does not fit in the frame mask");
+	std::array<uint32_t, 256> frames = {};
+	for (int neighbors = 0; neighbors < 256; neighbors++)
+	{
+		for (size_t n = 0; n < sizeof(rules21) / sizeof(*rules21); n++)
+		{
+			if ((neighbors & rules21[n].include) == rules21[n].include && !(neighbors & rules21[n].exclude))
+				frames[neighbors] |= 1u << n;
+		}
+	}
+	return frames;
+}();
 
 void Terrain::Draw(RenderContext &rc, const World& world, bool drawGrid, bool drawBackground) const
 {
@@ -83,32 +98,19 @@ void Terrain::Draw(RenderContext &rc, const World& world, bool drawGrid, bool dr
 	int ymax = std::min(world.GetBlockBounds().bottom - 1, (int)std::floor(visibleRegion.bottom / WORLD_BLOCK_SIZE + 0.5f));
 
 	for( int y0 = ymin; y0 <= ymax; ++y0 )
-	for( int x0 = xmin; x0 <= xmax; ++x0 )
 	{
-		if (int tileIndex = world.GetTileIndex(x0, y0); tileIndex != -1 && world._waterTiles[tileIndex])
-			continue;
-
-		int neighbors = 0;
-		for (int i = 0; i < 8; i++)
+		int tileIndex = world.GetTileIndex(xmin, y0);
+		for( int x0 = xmin; x0 <= xmax; ++x0, ++tileIndex )
 		{
-			auto x = x0 + dx[i];
-			auto y = y0 + dy[i];
-			auto tileIndex = world.GetTileIndex(x, y);
-			if (tileIndex != -1 && world._waterTiles[tileIndex])
-			{
-				neighbors |= 1u << i;
-			}
-		}
+			uint32_t frames = s_waterFrames[world._waterNeighbors[tileIndex]];
+			if (!frames || world._waterTiles[tileIndex])
+				continue;
 
-		if (neighbors)
-		{
 			auto rect = MakeRectWH(vec2d{ (float)x0, (float)y0 } *WORLD_BLOCK_SIZE, vec2d{ WORLD_BLOCK_SIZE, WORLD_BLOCK_SIZE });
-			for (auto rule : rules21)
+			for (size_t n = 0; frames; n++, frames >>= 1)
 			{
-				if ((neighbors & rule.include) == rule.include && !(neighbors & rule.exclude))
-				{
-					rc.DrawSprite(rect, _texWater, 0xffffffff, rule.frame);
-				}
+				if (frames & 1)
+					rc.DrawSprite(rect, _texWater, 0xffffffff, rules21[n].frame);
 			}
 		}
 	}
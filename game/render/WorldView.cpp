@@ -26,7 +26,8 @@ WorldView::~WorldView()
 void WorldView::Render(RenderContext &rc,
                        const World &world,
                        WorldViewRenderOptions options,
-                       const AIManager *aiManager) const
+                       const AIManager *aiManager,
+                       WorldViewCache *cache) const
 {
 	FRECT visibleRegion = rc.GetVisibleRegion();
 
@@ -40,35 +41,48 @@ void WorldView::Render(RenderContext &rc,
 		float xmax = std::min(world.GetBounds().right, visibleRegion.right);
 		float ymax = std::min(world.GetBounds().bottom, visibleRegion.bottom);
 
-		FOREACH( world.GetList(LIST_lights), const GC_Light, pLight )
+		// lights are kept in the location of their position, visit those that can reach the visible region
+		float margin = world._maxLightRenderRadius;
+		const RectRB &lb = world.GetLocationBounds();
+		int locXmin = std::max(lb.left, (int)std::floor((xmin - margin) / WORLD_LOCATION_SIZE));
+		int locYmin = std::max(lb.top, (int)std::floor((ymin - margin) / WORLD_LOCATION_SIZE));
+		int locXmax = std::min(lb.right - 1, (int)std::floor((xmax + margin) / WORLD_LOCATION_SIZE));
+		int locYmax = std::min(lb.bottom - 1, (int)std::floor((ymax + margin) / WORLD_LOCATION_SIZE));
+
+		// consecutive fans share a batch, there are no state changes between the lights
+		for( int locY = locYmin; locY <= locYmax; ++locY )
+		for( int locX = locXmin; locX <= locXmax; ++locX )
 		{
-			if( pLight->GetActive() &&
-				pLight->GetPos().x + pLight->GetRenderRadius() > xmin &&
-				pLight->GetPos().x - pLight->GetRenderRadius() < xmax &&
-				pLight->GetPos().y + pLight->GetRenderRadius() > ymin &&
-				pLight->GetPos().y - pLight->GetRenderRadius() < ymax )
+			FOREACH( world.grid_lights.element(locX, locY), const GC_Light, pLight )
 			{
-				float intensity = pLight->GetIntensity();
-				if (pLight->GetFade())
+				if( pLight->GetActive() &&
+					pLight->GetPos().x + pLight->GetRenderRadius() > xmin &&
+					pLight->GetPos().x - pLight->GetRenderRadius() < xmax &&
+					pLight->GetPos().y + pLight->GetRenderRadius() > ymin &&
+					pLight->GetPos().y - pLight->GetRenderRadius() < ymax )
 				{
-					float age = (world.GetTime() - pLight->GetStartTime()) / pLight->GetTimeout();
-					intensity *= 1.0f - age*age*age;
-				}
-				switch (pLight->GetLightType())
-				{
-					case GC_Light::LIGHT_POINT:
-						rc.DrawPointLight(intensity, pLight->GetRadius(), pLight->GetPos());
-						break;
-					case GC_Light::LIGHT_SPOT:
-						rc.DrawSpotLight(intensity, pLight->GetRadius(), pLight->GetPos(),
-						                 pLight->GetLightDirection(), pLight->GetOffset(), pLight->GetAspect());
-						break;
-					case GC_Light::LIGHT_DIRECT:
-						rc.DrawDirectLight(intensity, pLight->GetRadius(), pLight->GetPos(),
-						                   pLight->GetLightDirection(), pLight->GetLength());
-						break;
-					default:
-						assert(false);
+					float intensity = pLight->GetIntensity();
+					if (pLight->GetFade())
+					{
+						float age = (world.GetTime() - pLight->GetStartTime()) / pLight->GetTimeout();
+						intensity *= 1.0f - age*age*age;
+					}
+					switch (pLight->GetLightType())
+					{
+						case GC_Light::LIGHT_POINT:
+							rc.DrawPointLight(intensity, pLight->GetRadius(), pLight->GetPos());
+							break;
+						case GC_Light::LIGHT_SPOT:
+							rc.DrawSpotLight(intensity, pLight->GetRadius(), pLight->GetPos(),
+							                 pLight->GetLightDirection(), pLight->GetOffset(), pLight->GetAspect());
+							break;
+						case GC_Light::LIGHT_DIRECT:
+							rc.DrawDirectLight(intensity, pLight->GetRadius(), pLight->GetPos(),
+							                   pLight->GetLightDirection(), pLight->GetLength());
+							break;
+						default:
+							assert(false);
+					}
 				}
 			}
 		}
@@ -81,17 +95,19 @@ void WorldView::Render(RenderContext &rc,
 	int ymin = std::max(world.GetLocationBounds().top, (int)std::floor(visibleRegion.top / WORLD_LOCATION_SIZE - 0.5f));
 	int xmax = std::min(world.GetLocationBounds().right - 1, (int)std::floor(visibleRegion.right / WORLD_LOCATION_SIZE + 0.5f));
 	int ymax = std::min(world.GetLocationBounds().bottom - 1, (int)std::floor(visibleRegion.bottom / WORLD_LOCATION_SIZE + 0.5f));
-	for( int x = xmin; x <= xmax; ++x )
-	for( int y = ymin; y <= ymax; ++y )
+	RectRB range = (xmin <= xmax && ymin <= ymax) ? RectRB{ xmin, ymin, xmax + 1, ymax + 1 } : RectRB{};
+
+	WorldViewCache oneFrameCache;
+	WorldViewCache &visible = cache ? *cache : oneFrameCache;
+	UpdateCache(visible, world, range, options);
+	for( auto &location: visible._locations )
 	{
-		FOREACH(world.grid_moving.element(x, y), const GC_MovingObject, object)
+		for( auto &objectWithView: location.views )
 		{
-			for( auto &view: _renderScheme.GetViews(*object, options.editorMode, options.nightMode) )
-			{
-				enumZOrder z = view.zfunc->GetZ(world, *object);
-				if( Z_NONE != z && object->GetGridSet() )
-					zLayers[z].emplace_back(object, view.rfunc.get());
-			}
+			const GC_MovingObject *object = objectWithView.first;
+			enumZOrder z = objectWithView.second->zfunc->GetZ(world, *object);
+			if( Z_NONE != z && object->GetGridSet() )
+				zLayers[z].emplace_back(object, objectWithView.second->rfunc.get());
 		}
 	}
 
@@ -114,12 +130,16 @@ void WorldView::Render(RenderContext &rc,
 
 	_terrain.Draw(rc, world, options.drawGrid, !options.noBackground);
 
+	// sprites of the same layer rarely overlap, let them be grouped by texture
+	rc.BeginDrawList();
 	for( int z = 0; z < Z_COUNT; ++z )
 	{
+		rc.SetDrawLayer(z);
 		for( auto &moWithView: zLayers[z] )
 			moWithView.second->Draw(world, *moWithView.first, rc);
 		zLayers[z].clear();
 	}
+	rc.EndDrawList();
 
 	rc.SetMode(RM_INTERFACE);
 
@@ -164,6 +184,57 @@ void WorldView::Render(RenderContext &rc,
 	}
 }
 
+void WorldView::UpdateCache(WorldViewCache &cache, const World &world, RectRB range, const WorldViewRenderOptions &options) const
+{
+	if( cache._world != &world || cache._worldSerial != world.GetSerial() || cache._renderScheme != &_renderScheme ||
+	    cache._editorMode != options.editorMode || cache._nightMode != options.nightMode )
+	{
+		cache._world = &world;
+		cache._worldSerial = world.GetSerial();
+		cache._renderScheme = &_renderScheme;
+		cache._editorMode = options.editorMode;
+		cache._nightMode = options.nightMode;
+		cache._range = {};
+		cache._locations.clear();
+	}
+
+	// locations that stay in view keep what was found there
+	if( range.left != cache._range.left || range.top != cache._range.top ||
+	    range.right != cache._range.right || range.bottom != cache._range.bottom )
+	{
+		std::vector<WorldViewCache::Location> locations(WIDTH(range) * HEIGHT(range));
+		for( int x = range.left; x < range.right; ++x )
+		for( int y = range.top; y < range.bottom; ++y )
+		{
+			if( PtInRect(cache._range, x, y) )
+			{
+				locations[(x - range.left) * HEIGHT(range) + y - range.top] =
+					std::move(cache._locations[(x - cache._range.left) * HEIGHT(cache._range) + y - cache._range.top]);
+			}
+		}
+		cache._locations.swap(locations);
+		cache._range = range;
+	}
+
+	for( int x = range.left; x < range.right; ++x )
+	for( int y = range.top; y < range.bottom; ++y )
+	{
+		WorldViewCache::Location &location = cache._locations[(x - range.left) * HEIGHT(range) + y - range.top];
+		unsigned int revision = world.grid_moving_revisions.element(x, y);
+		if( !location.valid || location.revision != revision )
+		{
+			location.views.clear();
+			FOREACH(world.grid_moving.element(x, y), const GC_MovingObject, object)
+			{
+				for( auto &view: _renderScheme.GetViews(*object, options.editorMode, options.nightMode) )
+					location.views.emplace_back(object, &view);
+			}
+			location.revision = revision;
+			location.valid = true;
+		}
+	}
+}
+
 vec2d ComputeWorldTransformOffset(const FRECT &canvasViewport, vec2d eye, float zoom)
 {
 	vec2d eyeOffset = Vec2dFloor(eye * zoom - Size(canvasViewport) / 2);
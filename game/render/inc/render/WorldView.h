@@ -2,12 +2,16 @@
 
 #include "Terrain.h"
 #include <math/MyMath.h>
+#include <utility>
+#include <vector>
 
 class AIManager;
+class GC_MovingObject;
 class RenderContext;
 class TextureManager;
 class RenderScheme;
 class World;
+struct ObjectView;
 
 struct WorldViewRenderOptions
 {
@@ -19,6 +23,29 @@ struct WorldViewRenderOptions
 	bool visualizePath = false;
 };
 
+// The views of the objects found in the locations around the visible region.
+// Kept between the frames of one camera so that a location is scanned again only when
+// it comes into view or objects enter or leave it. The z order is still evaluated every frame.
+class WorldViewCache final
+{
+	friend class WorldView;
+
+	struct Location
+	{
+		unsigned int revision;
+		bool valid;
+		std::vector<std::pair<const GC_MovingObject*, const ObjectView*>> views;
+	};
+
+	const World *_world = nullptr;
+	unsigned int _worldSerial = 0;
+	const RenderScheme *_renderScheme = nullptr;
+	bool _editorMode = false;
+	bool _nightMode = false;
+	RectRB _range = {}; // of locations
+	std::vector<Location> _locations; // column by column
+};
+
 class WorldView final
 {
 public:
@@ -27,7 +54,8 @@ public:
 	void Render(RenderContext &rc,
 	            const World &world,
 	            WorldViewRenderOptions options = {},
-	            const AIManager *aiManager = nullptr) const;
+	            const AIManager *aiManager = nullptr,
+	            WorldViewCache *cache = nullptr) const;
 	RenderScheme &GetRenderScheme() const { return _renderScheme; }
 
 private:
@@ -35,6 +63,8 @@ private:
 	Terrain _terrain;
 	size_t _lineTex;
 	size_t _texField;
+
+	void UpdateCache(WorldViewCache &cache, const World &world, RectRB range, const WorldViewRenderOptions &options) const;
 };
 
 vec2d ComputeWorldTransformOffset(const FRECT &canvasViewport, vec2d eye, float zoom);
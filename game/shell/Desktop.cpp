@@ -4,6 +4,7 @@
 #include "gui.h"
 #include "LuaConsole.h"
 #include "MainMenu.h"
+#include "MapThumbnails.h"
 #include "NavStack.h"
 #include "SelectMapDlg.h"
 #include "Settings.h"
@@ -18,6 +19,7 @@
 #include <as/MapCollection.h>
 #include <cbind/ConfigBinding.h>
 #include <ctx/EditorContext.h>
+#include <ctx/GameContext.h>
 #include <editor/EditorMain.h>
 #include <editor/MapSettings.h>
 #include <gc/World.h>
@@ -74,6 +76,7 @@ Desktop::Desktop(UI::TimeStepManager &manager,
 	, _cmdCloseAppWindow(cmdClose)
 	, _renderScheme(texman)
 	, _worldView(texman, _renderScheme)
+	, _mapThumbnails(std::make_unique<MapThumbnails>(fs, texman, _worldView, mapCollection))
 {
 	using namespace std::placeholders;
 	using namespace UI::DataSourceAliases;
@@ -213,20 +216,22 @@ void Desktop::OnSinglePlayer()
 
 	if (_dmCampaign.tiers.GetSize() > 0)
 	{
-		auto dlg = std::make_shared<SinglePlayer>(_worldView, _fs, _appConfig, _conf, _dmCampaign, _mapCollection, _lang);
-		dlg->eventSelectMap = [this, weakSender = std::weak_ptr<SinglePlayer>(dlg)](int index)
+		auto dlg = std::make_shared<SinglePlayer>(GetTimeStepManager(), _fs, *_mapThumbnails, _appConfig, _conf, _dmCampaign, _mapCollection, _lang);
+		dlg->eventSelectMap = [this, weakSender = std::weak_ptr<SinglePlayer>(dlg)](int index, MapLoading &loading)
 		{
 			if (auto sender = weakSender.lock())
 			{
 				_conf.sp_map.SetInt(index);
 				try
 				{
-					// previous game/editor context may be held by UI, release it first to prevent memory spike
+					// previous game/editor context may be held by UI; the new world is already
+					// loaded by now, so this only keeps the old one from outliving the new game
 					_navStack->Trim();
+					_mapThumbnails->ReleaseRenderer();
 
 					int currentTier = GetCurrentTier(_conf, _dmCampaign);
 					int currentMap = GetCurrentMap(_conf, _dmCampaign);
-					_appController.StartDMCampaignMap(GetAppState(), _mapCollection, _appConfig, _dmCampaign, currentTier, currentMap);
+					_appController.StartDMCampaignMap(GetAppState(), loading.TakeWorld(), _appConfig, _dmCampaign, currentTier, currentMap);
 				}
 				catch (const std::exception & e)
 				{
@@ -243,7 +248,7 @@ void Desktop::OnSplitScreen()
 	if (_navStack->IsOnStack<NewGameDlg>() || _navStack->IsOnStack<SinglePlayer>())
 		return;
 
-	auto dlg = std::make_shared<NewGameDlg>(_texman, _fs, _conf, _logger, _lang);
+	auto dlg = std::make_shared<NewGameDlg>(_texman, _fs, _mapCollection, _conf, _logger, _lang);
 	dlg->eventClose = [this, weakSender = std::weak_ptr<NewGameDlg>(dlg)](int result)
 	{
 		if (auto sender = weakSender.lock())
@@ -267,13 +272,14 @@ void Desktop::OnSplitScreen()
 
 void Desktop::OnOpenMap()
 {
-	auto selectMapDlg = std::make_shared<SelectMapDlg>(_fs, _worldView, _conf, _lang, _mapCollection);
+	auto selectMapDlg = std::make_shared<SelectMapDlg>(*_mapThumbnails, _conf, _lang, _mapCollection);
 	selectMapDlg->eventMapSelected = [this, weakSender = std::weak_ptr<SelectMapDlg>(selectMapDlg)](unsigned int mapIndex)
 	{
 		if (auto sender = weakSender.lock())
 		{
 			// previous game/editor context may be held by UI, release it first to prevent memory spike
 			_navStack->Trim();
+			_mapThumbnails->ReleaseRenderer();
 			_appController.StartNewMapEditor(GetAppState(), _mapCollection, _conf.editor.width.GetInt(), _conf.editor.height.GetInt(),
 				mapIndex != -1 ? _mapCollection.GetMapName(mapIndex) : "");
 		}
@@ -317,6 +323,36 @@ void Desktop::OnExportMap()
 	}
 }
 
+void Desktop::OnQuickSave()
+{
+	auto gameContext = std::dynamic_pointer_cast<GameContext>(GetAppState().GetGameContext());
+	if (!gameContext || gameContext->IsSaveInProgress())
+		return;
+
+	try
+	{
+		auto folder = _fs.GetFileSystem("user")->GetFileSystem(DIR_SAVES, true /* create */);
+		auto stream = folder->Open(FILE_QUICKSAVE, FS::ModeWrite)->QueryStream();
+		gameContext->SerializeAsync(std::move(stream), [&logger = _logger](std::exception_ptr error)
+		{
+			try
+			{
+				if (error)
+					std::rethrow_exception(error);
+				logger.Printf(0, "game saved: '%s/%s'", DIR_SAVES, FILE_QUICKSAVE);
+			}
+			catch (const std::exception &e)
+			{
+				logger.Printf(1, "Could not save game - %s", e.what());
+			}
+		});
+	}
+	catch (const std::exception &e)
+	{
+		_logger.Printf(1, "Could not save game - %s", e.what());
+	}
+}
+
 void Desktop::OnSettingsMain()
 {
 	if (_navStack->IsOnStack<MainSettingsDlg>())
@@ -465,6 +501,10 @@ bool Desktop::OnKeyPressed(const Plat::Input &input, const UI::InputContext &ic,
 		OnSettingsMain();
 		break;
 
+	case Plat::Key::F5:
+		OnQuickSave();
+		break;
+
 	case Plat::Key::F8:
 		OnMapSettings();
 		break;
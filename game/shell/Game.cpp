@@ -6,11 +6,14 @@
 #include "ScoreTable.h"
 #include "VehicleStateReader.h"
 #include "inc/shell/Config.h"
+#include "inc/shell/Profiler.h"
 
+#include <ctx/AIManager.h>
 #include <ctx/Deathmatch.h>
 #include <ctx/GameContext.h>
 #include <ctx/WorldController.h>
 #include <gc/Player.h>
+#include <gc/TraceCache.h>
 #include <gc/Vehicle.h>
 #include <gc/World.h>
 #include <loc/Language.h>
@@ -26,6 +29,7 @@
 #include <video/RenderContext.h>
 #include <video/TextureManager.h>
 
+#include <algorithm>
 #include <cfloat>
 #include <iomanip>
 #include <sstream>
@@ -95,6 +99,13 @@ namespace
 
 constexpr float showScoreDelay = 0.5f;
 
+static CounterBase counterAIAllowed("ai allowed", "AI decisions allowed by the time budget");
+static CounterBase counterAIDecisions("ai decisions", "AI decisions per step");
+static CounterBase counterAIDeferred("ai deferred", "AI deferred decisions");
+static CounterBase counterAITime("ai time", "AI decision time, ms");
+static CounterBase counterTraceHits("trace hits", "Cached trace hits per step");
+static CounterBase counterTraceMisses("trace misses", "Cached trace misses per step");
+
 
 GameLayout::GameLayout(UI::TimeStepManager &manager,
                        std::shared_ptr<GameContext> gameContext,
@@ -155,6 +166,8 @@ GameLayout::GameLayout(UI::TimeStepManager &manager,
 		_scoreAndControls->SetFocus(_campaignControls.get());
 	}
 
+	_gameContext->GetAIManager().SetDecisionBudget(std::chrono::microseconds(std::max(0, _conf.g_aibudget.GetInt())));
+
 	SetTimeStep(true);
 	_gameContext->GetGameEventSource().AddListener(*this);
 }
@@ -275,6 +288,16 @@ void GameLayout::OnTimeStep(const Plat::Input &input, bool focused, float dt)
 
 	_gameViewHarness.Step(dt);
 
+	const AIManager::SchedulerStats &aiStats = _gameContext->GetAIManager().GetSchedulerStats();
+	counterAIAllowed.Push((float)aiStats.allowed);
+	counterAIDecisions.Push((float)aiStats.decisions);
+	counterAIDeferred.Push((float)aiStats.deferred);
+	counterAITime.Push((float)aiStats.elapsed.count() / 1000.0f);
+
+	const TraceCache::Stats &traceStats = _gameContext->GetWorld().GetTraceCache().GetStats();
+	counterTraceHits.Push((float)traceStats.hits);
+	counterTraceMisses.Push((float)traceStats.misses);
+
 	bool gameplayActive = focused && !_gamePauseMenu;
 
 	std::vector<GC_Player*> players = _worldController.GetLocalPlayers();
@@ -1,41 +1,33 @@
 #include "MapList.h"
 #include "inc/shell/Config.h"
 
-#include <as/AppConstants.h>
+#include <as/MapCollection.h>
 #include <fs/FileSystem.h>
-#include <MapFile.h>
 #include <plat/ConsoleBuffer.h>
 
 #include <sstream>
 #include <iomanip>
 
-ListDataSourceMaps::ListDataSourceMaps(FS::FileSystem &fs, Plat::ConsoleBuffer &logger)
+ListDataSourceMaps::ListDataSourceMaps(MapCollection &mapCollection, FS::FileSystem &fs, Plat::ConsoleBuffer &logger)
+	: MapCollectionListener(mapCollection)
+	, _fs(fs)
+	, _logger(logger)
 {
-	auto files = fs.GetFileSystem(DIR_MAPS)->EnumAllFiles("*.tzod");
-	for( auto it = files.begin(); it != files.end(); ++it )
+	// only the maps shipped with the game, user maps are opened from the editor
+	for (int mapIndex = 0; mapIndex < mapCollection.GetMapCount(); mapIndex++)
 	{
-		std::string tmp = DIR_MAPS;
-		tmp += "/";
-		tmp += *it;
+		if (!mapCollection.IsBuiltInMap(mapIndex))
+			continue;
 
 		try
 		{
-			MapFile file(*fs.Open(tmp)->QueryStream(), false);
-			std::string tmp2 = *it;
-			tmp2.erase(it->length() - 5); // cut out the file extension
-			int index = AddItem(tmp2);
-
-			std::ostringstream size;
-			int h = 0, w = 0;
-			file.getMapAttribute("width", w);
-			file.getMapAttribute("height", h);
-			size << std::setw(3) << w << "*" << std::setw(1) << h;
-			SetItemText(index, 1, size.str());
-
-			if( file.getMapAttribute("theme", tmp) )
-			{
-				SetItemText(index, 2, tmp);
-			}
+			// Use the indexed metadata as is, the background refresh will report stale entries.
+			const MapMetadata *metadata = mapCollection.FindMapMetadata(mapIndex);
+			if (!metadata)
+				metadata = &mapCollection.GetMapMetadata(fs, mapIndex);
+
+			int index = AddItem(mapCollection.GetMapName(mapIndex));
+			SetMetadata(index, *metadata);
 		}
 		catch( const std::exception &e )
 		{
@@ -45,3 +37,28 @@ ListDataSourceMaps::ListDataSourceMaps(FS::FileSystem &fs, Plat::ConsoleBuffer &
 
 	Sort();
 }
+
+void ListDataSourceMaps::SetMetadata(int index, const MapMetadata &metadata)
+{
+	std::ostringstream size;
+	size << std::setw(3) << metadata.width << "*" << std::setw(1) << metadata.height;
+	SetItemText(index, 1, size.str());
+	SetItemText(index, 2, metadata.theme);
+}
+
+void ListDataSourceMaps::OnMapMetadataChanged(int mapIndex)
+{
+	// user maps are never added to the list, but they override the built-in ones
+	int index = FindItem(GetMapCollection().GetMapName(mapIndex));
+	if (index != -1)
+	{
+		try
+		{
+			SetMetadata(index, GetMapCollection().GetMapMetadata(_fs, mapIndex));
+		}
+		catch( const std::exception &e )
+		{
+			_logger.Printf(1, "could not open get map attributes - %s", e.what());
+		}
+	}
+}
@@ -1,4 +1,5 @@
 #pragma once
+#include <as/MapCollection.h>
 #include <ui/List.h>
 
 namespace FS
@@ -11,9 +12,21 @@ namespace Plat
 	class ConsoleBuffer;
 }
 
-class ListDataSourceMaps : public UI::ListDataSourceDefault
+struct MapMetadata;
+
+class ListDataSourceMaps
+	: public UI::ListDataSourceDefault
+	, private MapCollectionListener
 {
 public:
-	ListDataSourceMaps(FS::FileSystem &fs, Plat::ConsoleBuffer &logger);
-};
+	ListDataSourceMaps(MapCollection &mapCollection, FS::FileSystem &fs, Plat::ConsoleBuffer &logger);
+
+private:
+	FS::FileSystem &_fs;
+	Plat::ConsoleBuffer &_logger;
 
+	void SetMetadata(int index, const MapMetadata &metadata);
+
+	// MapCollectionListener
+	void OnMapMetadataChanged(int mapIndex) override;
+};
@@ -1,19 +1,16 @@
 #include "MapPreview.h"
+#include "MapThumbnails.h"
 #include <as/MapCollection.h>
-#include <gc/World.h>
 #include <ui/DataSource.h>
 #include <ui/InputContext.h>
 #include <ui/LayoutContext.h>
 #include <ui/Rating.h>
 #include <ui/StateContext.h>
-#include <render/WorldView.h>
 #include <video/RenderContext.h>
 #include <video/TextureManager.h>
 
-MapPreview::MapPreview(FS::FileSystem &fs, WorldView &worldView, MapCollection &mapCollection)
-	: _fs(fs)
-	, _worldView(worldView)
-	, _mapCollection(mapCollection)
+MapPreview::MapPreview(MapThumbnails &mapThumbnails)
+	: _mapThumbnails(mapThumbnails)
 {
 }
 
@@ -43,20 +40,29 @@ void MapPreview::Draw(const UI::DataContext &dc, const UI::StateContext &sc, con
 	vec2d pxViewSize = lc.GetPixelSize() - pxPadding * 2;
 	FRECT pxContentRect = MakeRectWH(pxPadding, pxViewSize);
 
-	if (_mapName)
+	if (auto thumbnail = _mapName ? _mapThumbnails.GetThumbnail(_mapName->GetRenderValue(dc, sc)) : nullptr)
 	{
-		const World &world = _mapCollection.GetCachedWorld(_fs, _mapName->GetRenderValue(dc, sc));
-
-		vec2d worldSize = Size(world.GetBounds());
-		vec2d eye = Center(world.GetBounds());
-		float zoom = std::max(pxViewSize.x / worldSize.x, pxViewSize.y / worldSize.y);
+		// fill the view, cropping the longer side of the map
+		ImageView data = thumbnail->GetData();
+		vec2d pxImageSize = { (float)data.width, (float)data.height };
+		vec2d pxImageDrawSize = pxImageSize * std::max(pxViewSize.x / pxImageSize.x, pxViewSize.y / pxImageSize.y);
 
 		rc.PushClippingRect(FRectToRect(pxContentRect));
-		rc.PushWorldTransform(ComputeWorldTransformOffset(pxContentRect, eye, zoom), zoom, 1);
-		_worldView.Render(rc, world);
-		rc.PopTransform();
+		rc.DrawImage(MakeRectWH(pxPadding + (pxViewSize - pxImageDrawSize) / 2, pxImageDrawSize), thumbnail, 0xffffffff);
 		rc.PopClippingRect();
 	}
+	else
+	{
+		rc.DrawSprite(pxContentRect, _texPlaceholder.GetTextureId(texman), 0x88888888, 0);
+	}
+
+	if (_loading)
+	{
+		float pxBarHeight = std::floor(UI::ToPx(4, lc));
+		FRECT pxBar = MakeRectWH(vec2d{ pxContentRect.left, pxContentRect.bottom - pxBarHeight }, vec2d{ pxViewSize.x * _loading->GetProgress(), pxBarHeight });
+		rc.DrawSprite(pxContentRect, _texLockShade.GetTextureId(texman), 0xffffffff, 0);
+		rc.DrawSprite(pxBar, _texSelection.GetTextureId(texman), 0xffffffff, 0);
+	}
 
 	if (_locked)
 	{
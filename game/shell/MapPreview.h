@@ -3,13 +3,9 @@
 #include <ui/Window.h>
 #include <memory>
 #include <string>
-class MapCollection;
-class WorldView;
+class MapLoading;
+class MapThumbnails;
 
-namespace FS
-{
-	class FileSystem;
-}
 namespace UI
 {
 	class Rating;
@@ -20,24 +16,25 @@ class MapPreview final
 	: public UI::WindowContainer
 {
 public:
-	MapPreview(FS::FileSystem &fs, WorldView &worldView, MapCollection &mapCollection);
+	explicit MapPreview(MapThumbnails &mapThumbnails);
 
 	void SetMapName(std::shared_ptr<UI::RenderData<std::string_view>> mapName);
 	void SetRating(std::shared_ptr<UI::RenderData<unsigned int>> rating);
 	void SetPadding(float padding) { _padding = padding; }
 	void SetLocked(bool locked) { _locked = locked; }
+	void SetLoading(std::shared_ptr<const MapLoading> loading) { _loading = std::move(loading); }
 
 	// UI::Window
 	void Draw(const UI::DataContext &dc, const UI::StateContext &sc, const UI::LayoutContext &lc, const UI::InputContext &ic, RenderContext &rc, TextureManager &texman, const Plat::Input &input, float time, bool hovered) const override;
 	UI::WindowLayout GetChildLayout(TextureManager &texman, const UI::LayoutContext &lc, const UI::DataContext &dc, const UI::Window &child) const override;
 
 private:
-	FS::FileSystem &_fs;
-	WorldView &_worldView;
-	MapCollection &_mapCollection;
+	MapThumbnails &_mapThumbnails;
 	UI::Texture _texSelection = "ui/selection";
 	UI::Texture _texLock = "ui/lock";
 	UI::Texture _texLockShade = "ui/window";
+	UI::Texture _texPlaceholder = "ui/window";
+	std::shared_ptr<const MapLoading> _loading;
 	std::shared_ptr<UI::Rating> _rating;
 	std::shared_ptr<UI::RenderData<std::string_view>> _mapName;
 	float _padding = 0;
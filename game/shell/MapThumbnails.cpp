@@ -0,0 +1,227 @@
+#include "MapThumbnails.h"
+#include <as/AppConstants.h>
+#include <as/MapCollection.h>
+#include <fs/FileSystem.h>
+#include <gc/World.h>
+#include <render/WorldView.h>
+#include <video/EditableImage.h>
+#include <video/RenderBinding.h>
+#include <video/RenderContext.h>
+#include <video/RenderSoftware.h>
+#include <video/TextureManager.h>
+#include <MapFile.h>
+#include <algorithm>
+#include <cassert>
+#include <cinttypes>
+#include <cstdio>
+#include <stdexcept>
+#include <vector>
+
+static constexpr uint32_t THUMBNAIL_SIGNATURE = detail::MakeSignature("thm1");
+static constexpr float THUMBNAIL_SIZE = 256; // pixels along the shorter side of the map
+static constexpr int MAX_THUMBNAIL_SIDE = 1024;
+static constexpr size_t MAX_LOADED_THUMBNAILS = 64;
+static constexpr unsigned int MAX_LOADING_MAPS = 2;
+
+struct MapThumbnails::Offscreen
+{
+	RenderSoftware render;
+	RenderBinding binding;
+
+	~Offscreen()
+	{
+		binding.UnloadAllTextures(render);
+	}
+};
+
+// FNV-1a of the file contents, seeded with the thumbnail format
+// so that a change of the format does not pick up old files
+static uint64_t HashMapFile(FS::Stream &stream)
+{
+	uint64_t hash = 14695981039346656037ull ^ THUMBNAIL_SIGNATURE;
+	uint8_t buffer[4096];
+	while (size_t size = stream.Read(buffer, 1, sizeof(buffer)))
+	{
+		for (size_t i = 0; i < size; i++)
+		{
+			hash ^= buffer[i];
+			hash *= 1099511628211ull;
+		}
+	}
+	return hash;
+}
+
+template <class T>
+static void Write(FS::Stream &stream, T value)
+{
+	stream.Write(&value, sizeof(T));
+}
+
+template <class T>
+static T Read(FS::Stream &stream)
+{
+	T value;
+	if (1 != stream.Read(&value, sizeof(T), 1))
+		throw std::runtime_error("unexpected end of file");
+	return value;
+}
+
+static void WriteThumbnail(FS::Stream &stream, const Image &image)
+{
+	ImageView data = image.GetData();
+	assert(data.bpp == 32);
+	Write<uint32_t>(stream, THUMBNAIL_SIGNATURE);
+	Write<uint16_t>(stream, static_cast<uint16_t>(data.width));
+	Write<uint16_t>(stream, static_cast<uint16_t>(data.height));
+	for (int y = 0; y < data.height; y++)
+		stream.Write(static_cast<const uint8_t*>(data.pixels) + data.stride * y, data.width * 4);
+}
+
+static std::shared_ptr<const Image> ReadThumbnail(FS::Stream &stream)
+{
+	if (Read<uint32_t>(stream) != THUMBNAIL_SIGNATURE)
+		throw std::runtime_error("invalid thumbnail");
+
+	int width = Read<uint16_t>(stream);
+	int height = Read<uint16_t>(stream);
+	if (width == 0 || height == 0 || width > MAX_THUMBNAIL_SIDE || height > MAX_THUMBNAIL_SIDE)
+		throw std::runtime_error("invalid thumbnail size");
+
+	std::vector<uint32_t> pixels(width * height);
+	if (1 != stream.Read(pixels.data(), pixels.size() * 4, 1))
+		throw std::runtime_error("unexpected end of file");
+
+	auto image = std::make_shared<EditableImage>(width, height);
+	image->Blit(0, 0, 0, ImageView{ pixels.data(), width, height, width * 4, 32 });
+	return image;
+}
+
+MapThumbnails::MapThumbnails(FS::FileSystem &fs, TextureManager &texman, WorldView &worldView, MapCollection &mapCollection)
+	: _fs(fs)
+	, _texman(texman)
+	, _worldView(worldView)
+	, _mapCollection(mapCollection)
+{
+}
+
+MapThumbnails::~MapThumbnails()
+{
+}
+
+std::shared_ptr<const Image> MapThumbnails::GetThumbnail(std::string_view mapName)
+{
+	auto it = _thumbnails.find(mapName);
+	if (_thumbnails.end() == it)
+	{
+		if (_thumbnails.size() >= MAX_LOADED_THUMBNAILS)
+		{
+			// entries that are still loading are kept, releasing them would block on the loader
+			auto oldest = _thumbnails.end();
+			for (auto candidate = _thumbnails.begin(); candidate != _thumbnails.end(); ++candidate)
+			{
+				if (!candidate->second.loading && (_thumbnails.end() == oldest || candidate->second.lastUse < oldest->second.lastUse))
+					oldest = candidate;
+			}
+			if (_thumbnails.end() != oldest)
+				_thumbnails.erase(oldest);
+		}
+		it = _thumbnails.emplace(std::string(mapName), LoadFromDisk(mapName)).first;
+	}
+
+	Entry &entry = it->second;
+	entry.lastUse = ++_useCounter;
+	if (!entry.image && !entry.fileName.empty())
+		UpdateLoading(mapName, entry);
+	return entry.image;
+}
+
+void MapThumbnails::ReleaseRenderer()
+{
+	_offscreen.reset();
+}
+
+MapThumbnails::Entry MapThumbnails::LoadFromDisk(std::string_view mapName)
+{
+	Entry entry = {};
+	try
+	{
+		char fileName[32];
+		snprintf(fileName, sizeof(fileName), "%016" PRIx64 ".thumb", HashMapFile(*_mapCollection.QueryReadStream(_fs, std::string(mapName))));
+		entry.fileName = fileName;
+
+		auto folder = _fs.GetFileSystem("user")->GetFileSystem(DIR_THUMBNAILS, true /* create */, true /* nothrow */);
+		if (auto file = folder ? folder->Open(entry.fileName, FS::ModeRead, true /* nothrow */) : nullptr)
+			entry.image = ReadThumbnail(*file->QueryStream());
+	}
+	catch (const std::exception&)
+	{
+		// a damaged thumbnail is rendered again, an unreadable map keeps the empty file name
+	}
+	return entry;
+}
+
+void MapThumbnails::UpdateLoading(std::string_view mapName, Entry &entry)
+try
+{
+	if (!entry.loading)
+	{
+		if (_loadingCount < MAX_LOADING_MAPS)
+		{
+			entry.loading = _mapCollection.LoadWorldAsync(_fs, mapName);
+			_loadingCount++;
+		}
+	}
+	else if (entry.loading->IsReady())
+	{
+		auto loading = std::move(entry.loading);
+		_loadingCount--;
+
+		entry.image = Render(*loading->TakeWorld());
+
+		auto folder = _fs.GetFileSystem("user")->GetFileSystem(DIR_THUMBNAILS, true /* create */, true /* nothrow */);
+		if (folder)
+		{
+			try
+			{
+				WriteThumbnail(*folder->Open(entry.fileName, FS::ModeWrite)->QueryStream(), *entry.image);
+			}
+			catch (const std::exception&)
+			{
+				// read-only user folder, the thumbnail will be rendered again next time
+			}
+		}
+	}
+}
+catch (const std::exception&)
+{
+	entry.fileName.clear();
+}
+
+std::shared_ptr<const Image> MapThumbnails::Render(const World &world)
+{
+	vec2d worldSize = Size(world.GetBounds());
+	float zoom = std::min(THUMBNAIL_SIZE / std::min(worldSize.x, worldSize.y),
+	                      (float)MAX_THUMBNAIL_SIDE / std::max(worldSize.x, worldSize.y));
+	int width = std::max(1, (int)(worldSize.x * zoom));
+	int height = std::max(1, (int)(worldSize.y * zoom));
+
+	if (!_offscreen)
+		_offscreen = std::make_unique<Offscreen>();
+
+	ImageCache imageCache;
+	_offscreen->binding.Update(RenderBindingEnv{ _fs, _texman, imageCache, _offscreen->render });
+
+	_offscreen->render.Begin(width, height, DO_0);
+	{
+		RenderContext rc(_texman, _offscreen->binding, _offscreen->render, width, height);
+		FRECT viewport = { 0, 0, (float)width, (float)height };
+		rc.PushWorldTransform(ComputeWorldTransformOffset(viewport, Center(world.GetBounds()), zoom), zoom, 1);
+		_worldView.Render(rc, world);
+		rc.PopTransform();
+	}
+	_offscreen->render.End();
+
+	auto image = std::make_shared<EditableImage>(width, height);
+	image->Blit(0, 0, 0, _offscreen->render.GetPixels());
+	return image;
+}
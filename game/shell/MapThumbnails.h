@@ -0,0 +1,59 @@
+#pragma once
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+
+class Image;
+class MapCollection;
+class MapLoading;
+class TextureManager;
+class World;
+class WorldView;
+
+namespace FS
+{
+	class FileSystem;
+}
+
+// Pictures of whole maps for the map lists. Each one is rendered offscreen once and
+// saved to the user folder under the hash of the map file, so previews neither keep
+// imported worlds in memory nor import them again on the next run.
+// Maps that have no thumbnail yet are imported on background threads.
+class MapThumbnails final
+{
+public:
+	MapThumbnails(FS::FileSystem &fs, TextureManager &texman, WorldView &worldView, MapCollection &mapCollection);
+	~MapThumbnails();
+
+	// null while the map is being loaded or if it can't be read
+	std::shared_ptr<const Image> GetThumbnail(std::string_view mapName);
+
+	// Frees the offscreen renderer and its copy of the textures.
+	// It is created again when a thumbnail that is not on disk is requested.
+	void ReleaseRenderer();
+
+private:
+	struct Entry
+	{
+		std::shared_ptr<const Image> image;
+		std::shared_ptr<MapLoading> loading;
+		std::string fileName; // in the user folder, empty if the map can't be read
+		unsigned int lastUse;
+	};
+	struct Offscreen;
+
+	FS::FileSystem &_fs;
+	TextureManager &_texman;
+	WorldView &_worldView;
+	MapCollection &_mapCollection;
+	std::map<std::string, Entry, std::less<>> _thumbnails;
+	unsigned int _useCounter = 0;
+	unsigned int _loadingCount = 0;
+	std::unique_ptr<Offscreen> _offscreen;
+
+	Entry LoadFromDisk(std::string_view mapName);
+	void UpdateLoading(std::string_view mapName, Entry &entry);
+	std::shared_ptr<const Image> Render(const World &world);
+};
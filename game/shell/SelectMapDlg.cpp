@@ -1,9 +1,9 @@
 #include "inc/shell/Config.h"
 #include "MapPreview.h"
+#include "MapThumbnails.h"
 #include "SelectMapDlg.h"
 #include <as/MapCollection.h>
 #include <loc/Language.h>
-#include <render/WorldView.h>
 #include <ui/Button.h>
 #include <ui/DataSource.h>
 #include <ui/LayoutContext.h>
@@ -11,10 +11,9 @@
 #include <ui/ScrollView.h>
 #include <ui/StackLayout.h>
 
-SelectMapDlg::SelectMapDlg(FS::FileSystem& fsRoot, WorldView &worldView, ShellConfig &conf, LangCache &lang, MapCollection &mapCollection)
+SelectMapDlg::SelectMapDlg(MapThumbnails &mapThumbnails, ShellConfig &conf, LangCache &lang, MapCollection &mapCollection)
 	: MapCollectionListener(mapCollection)
-	, _fs(fsRoot)
-	, _worldView(worldView)
+	, _mapThumbnails(mapThumbnails)
 	, _conf(conf)
 	, _mapCollection(mapCollection)
 	, _mapTiles(std::make_shared<UI::ScanlineLayout>())
@@ -50,7 +49,7 @@ void SelectMapDlg::OnMapAdded(int newMapIndex)
 
 std::shared_ptr<UI::ContentButton> SelectMapDlg::MakeMapTileButton(int mapIndex)
 {
-	auto mapPreview = std::make_shared<MapPreview>(_fs, _worldView, _mapCollection);
+	auto mapPreview = std::make_shared<MapPreview>(_mapThumbnails);
 	mapPreview->Resize(_conf.ui_tile_size.GetFloat(), _conf.ui_tile_size.GetFloat());
 	mapPreview->SetPadding(_conf.ui_tile_spacing.GetFloat() / 2);
 	mapPreview->SetMapName(std::make_shared<UI::StaticText>(GetMapCollection().GetMapName(mapIndex)));
@@ -2,11 +2,6 @@
 #include <ui/ScrollView.h>
 #include <as/MapCollection.h>
 
-namespace FS
-{
-	class FileSystem;
-}
-
 namespace UI
 {
 	class ContentButton;
@@ -16,19 +11,19 @@ namespace UI
 class ShellConfig;
 class LangCache;
 class MapCollection;
+class MapThumbnails;
 
 class SelectMapDlg final
 	: public UI::ScrollView
 	, private MapCollectionListener
 {
 public:
-	SelectMapDlg(FS::FileSystem &fsRoot, WorldView& worldView, ShellConfig &conf, LangCache &lang, MapCollection &mapCollection);
+	SelectMapDlg(MapThumbnails &mapThumbnails, ShellConfig &conf, LangCache &lang, MapCollection &mapCollection);
 
 	std::function<void(unsigned int)> eventMapSelected;
 
 private:
-	FS::FileSystem& _fs;
-	WorldView &_worldView;
+	MapThumbnails &_mapThumbnails;
 	ShellConfig &_conf;
 	MapCollection& _mapCollection;
 	std::shared_ptr<UI::ScanlineLayout> _mapTiles;
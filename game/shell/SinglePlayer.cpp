@@ -1,13 +1,13 @@
 #include "BotView.h"
 #include "MapPreview.h"
+#include "MapThumbnails.h"
 #include "PlayerView.h"
 #include "SinglePlayer.h"
 #include "inc/shell/Config.h"
 #include <MapFile.h>
+#include <as/MapCollection.h>
 #include <cbind/ConfigBinding.h>
-#include <gc/World.h>
 #include <loc/Language.h>
-#include <render/WorldView.h>
 #include <video/RenderContext.h>
 #include <ui/Button.h>
 #include <ui/DataContext.h>
@@ -215,9 +215,10 @@ namespace
 	};
 }
 
-SinglePlayer::SinglePlayer(WorldView &worldView, FS::FileSystem &fs, AppConfig &appConfig, ShellConfig &conf, DMCampaign &dmCampaign, MapCollection &mapCollection, const LangCache& lang)
-	: _worldView(worldView)
+SinglePlayer::SinglePlayer(UI::TimeStepManager &manager, FS::FileSystem &fs, MapThumbnails &mapThumbnails, AppConfig &appConfig, ShellConfig &conf, DMCampaign &dmCampaign, MapCollection &mapCollection, const LangCache& lang)
+	: UI::TimeStepping(manager)
 	, _fs(fs)
+	, _mapThumbnails(mapThumbnails)
 	, _appConfig(appConfig)
 	, _conf(conf)
 	, _dmCampaign(dmCampaign)
@@ -290,6 +291,7 @@ void SinglePlayer::UpdateTier()
 	DMCampaignTier tierDesc(&_dmCampaign.tiers.GetTable(currentTier));
 
 	_mapTiles->UnlinkAllChildren();
+	_mapPreviews.clear();
 
 	bool locked = currentTier> 0 && GetTierRating(_dmCampaign, _appConfig, currentTier - 1) == 0;
 	int currentMap = GetCurrentMap(_conf, _dmCampaign);
@@ -300,12 +302,15 @@ void SinglePlayer::UpdateTier()
 
         auto mpButton = std::make_shared<UI::ContentButton>();
         {
-            auto mapPreview = std::make_shared<MapPreview>(_fs, _worldView, _mapCollection);
+            auto mapPreview = std::make_shared<MapPreview>(_mapThumbnails);
             mapPreview->Resize(_conf.ui_tile_size.GetFloat(), _conf.ui_tile_size.GetFloat());
             mapPreview->SetPadding(_conf.ui_tile_spacing.GetFloat() / 2);
             mapPreview->SetMapName(std::make_shared<UI::StaticText>(mapDesc.map_name.Get()));
             mapPreview->SetRating(std::make_shared<TierProgressIndexBinding>(_appConfig, _conf, _dmCampaign, mapIndex));
             mapPreview->SetLocked(locked);
+            if (_loading && _loadingTier == currentTier && _loadingMap == (int)mapIndex)
+                mapPreview->SetLoading(_loading);
+            _mapPreviews.push_back(mapPreview);
 
             mpButton->SetContent(mapPreview);
         }
@@ -338,9 +343,34 @@ int SinglePlayer::GetNextTier(UI::Navigate navigate) const
 
 void SinglePlayer::OnOK(int index)
 {
-	if (eventSelectMap)
+	if (_loading)
+		return;
+
+	_loadingTier = GetCurrentTier(_conf, _dmCampaign);
+	_loadingMap = index;
+
+	DMCampaignTier tierDesc(&_dmCampaign.tiers.GetTable(_loadingTier));
+	DMCampaignMapDesc mapDesc(&tierDesc.maps.GetTable(index));
+	_loading = _mapCollection.LoadWorldAsync(_fs, mapDesc.map_name.Get());
+
+	_mapPreviews[index]->SetLoading(_loading);
+	SetTimeStep(true);
+}
+
+void SinglePlayer::OnTimeStep(const Plat::Input &input, bool focused, float dt)
+{
+	if (!_loading || !_loading->IsReady())
+		return;
+
+	SetTimeStep(false);
+	auto loading = std::move(_loading);
+	for (auto &mapPreview: _mapPreviews)
+		mapPreview->SetLoading(nullptr);
+
+	// the player may have switched to another tier in the meantime
+	if (eventSelectMap && _loadingTier == GetCurrentTier(_conf, _dmCampaign))
 	{
-		eventSelectMap(index);
+		eventSelectMap(_loadingMap, *loading);
 	}
 }
 
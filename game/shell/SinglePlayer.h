@@ -10,9 +10,10 @@ class AppConfig;
 class ShellConfig;
 class LangCache;
 class DMCampaign;
+class MapCollection;
+class MapLoading;
 class MapPreview;
-class World;
-class WorldView;
+class MapThumbnails;
 namespace FS
 {
 	class FileSystem;
@@ -27,11 +28,13 @@ namespace UI
 class SinglePlayer final
 	: public UI::WindowContainer
 	, private UI::NavigationSink
+	, private UI::TimeStepping
 {
 public:
-	SinglePlayer(WorldView &worldView, FS::FileSystem &fs, AppConfig &appConfig, ShellConfig &conf, DMCampaign &dmCampaign, MapCollection& mapCollection, const LangCache &lang);
+	SinglePlayer(UI::TimeStepManager &manager, FS::FileSystem &fs, MapThumbnails &mapThumbnails, AppConfig &appConfig, ShellConfig &conf, DMCampaign &dmCampaign, MapCollection& mapCollection, const LangCache &lang);
 
-	std::function<void(int)> eventSelectMap;
+	// the map is loaded in the background first
+	std::function<void(int, MapLoading&)> eventSelectMap;
 
 	// UI::Window
 	UI::WindowLayout GetChildLayout(TextureManager &texman, const UI::LayoutContext &lc, const UI::DataContext &dc, const UI::Window &child) const override;
@@ -43,8 +46,8 @@ private:
 	void UpdateTier();
 	void OnOK(int index);
 
-	WorldView &_worldView;
 	FS::FileSystem &_fs;
+	MapThumbnails &_mapThumbnails;
 	AppConfig &_appConfig;
 	ShellConfig &_conf;
 	DMCampaign &_dmCampaign;
@@ -54,6 +57,14 @@ private:
 	std::shared_ptr<UI::StackLayout> _content;
 	std::shared_ptr<UI::StackLayout> _mapTiles;
 	std::shared_ptr<UI::List> _tierSelector;
+	std::vector<std::shared_ptr<MapPreview>> _mapPreviews;
+
+	std::shared_ptr<MapLoading> _loading;
+	int _loadingTier = -1;
+	int _loadingMap = -1;
+
+	// UI::TimeStepping
+	void OnTimeStep(const Plat::Input &input, bool focused, float dt) override;
 
 	// UI::NavigationSink
 	bool CanNavigate(TextureManager& texman, const UI::LayoutContext& lc, const UI::DataContext& dc, UI::Navigate navigate) const override;
@@ -31,7 +31,7 @@
 #define MAX_TIMELIMIT   1000
 #define MAX_FRAGLIMIT   10000
 
-NewGameDlg::NewGameDlg(TextureManager &texman, FS::FileSystem &fs, ShellConfig &conf, Plat::ConsoleBuffer &logger, LangCache &lang)
+NewGameDlg::NewGameDlg(TextureManager &texman, FS::FileSystem &fs, MapCollection &mapCollection, ShellConfig &conf, Plat::ConsoleBuffer &logger, LangCache &lang)
   : _texman(texman)
   , _conf(conf)
   , _lang(lang)
@@ -59,7 +59,7 @@ NewGameDlg::NewGameDlg(TextureManager &texman, FS::FileSystem &fs, ShellConfig &
 	mapListItemTemplate->EnsureColumn(1, 384); // size
 	mapListItemTemplate->EnsureColumn(2, 448); // theme
 
-	_maps = std::make_shared<MapList>(fs, logger);
+	_maps = std::make_shared<MapList>(mapCollection, fs, logger);
 	_maps->GetList()->SetCurSel(_maps->GetData()->FindItem(conf.cl_map.Get()));
 	_maps->GetList()->SetItemTemplate(mapListItemTemplate);
 //	_maps->SetScrollPos(_maps->GetCurSel() - (_maps->GetNumLinesVisible() - 1) * 0.5f);
@@ -3,6 +3,7 @@
 #include <ui/Dialog.h>
 
 class LangCache;
+class MapCollection;
 class TextureManager;
 namespace FS
 {
@@ -31,7 +32,7 @@ class NewGameDlg
 	: public UI::Dialog
 {
 public:
-	NewGameDlg(TextureManager &texman, FS::FileSystem &fs, ShellConfig &conf, Plat::ConsoleBuffer &logger, LangCache &lang);
+	NewGameDlg(TextureManager &texman, FS::FileSystem &fs, MapCollection &mapCollection, ShellConfig &conf, Plat::ConsoleBuffer &logger, LangCache &lang);
 	~NewGameDlg() override;
 
 	bool OnKeyPressed(const Plat::Input &input, const UI::InputContext &ic, Plat::Key key) override;
@@ -44,6 +44,7 @@ REFLECTION_BEGIN(ShellConfig) //  var_name  def_value
 	VAR_INT(  r_freq,             0 )
 	VAR_BOOL( r_fullscreen,   false )
 	VAR_BOOL( r_vsync,         true )
+	VAR_BOOL( r_thread,       false )  // play recorded frames on a separate thread
 
 	// server settings
 	VAR_STR(    sv_name,   "ZOD server" )
@@ -77,6 +78,7 @@ REFLECTION_BEGIN(ShellConfig) //  var_name  def_value
 
 	// game
 	VAR_BOOL( g_shownames, true )
+	VAR_INT(  g_aibudget,  2000 ) // microseconds per step for AI decisions
 
 	// console
 	VAR_INT(   con_maxhistory,        30 )
@@ -35,6 +35,7 @@ class LangCache;
 class LuaConsole;
 class MainMenuDlg;
 class MapCollection;
+class MapThumbnails;
 class NavStack;
 
 class Desktop final
@@ -99,12 +100,14 @@ private:
 
 	RenderScheme _renderScheme;
 	WorldView _worldView;
+	std::unique_ptr<MapThumbnails> _mapThumbnails;
 
 	void OnNewCampaign();
 	void OnSinglePlayer();
 	void OnSplitScreen();
 	void OnOpenMap();
 	void OnExportMap();
+	void OnQuickSave();
 	void OnSettingsMain();
 	void OnPlayerSettings();
 	void OnControlsSettings();
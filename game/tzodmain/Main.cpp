@@ -12,6 +12,7 @@ using FileSystem = FS::FileSystemPosix;
 #include <plat/Folders.h>
 #include <platglfw/GlfwAppWindow.h>
 #include <platglfw/Timer.h>
+#include <shell/Config.h>
 #include <exception>
 
 static void print_what(std::ostream &os, const std::exception &e, std::string prefix = std::string())
@@ -62,7 +63,8 @@ try
 		TZOD_VERSION,
 		false, // conf.r_fullscreen.Get(),
 		1024, //app.GetShellConfig().r_width.GetInt(),
-		768 //app.GetShellConfig().r_height.GetInt()
+		768, //app.GetShellConfig().r_height.GetInt()
+		app.GetShellConfig().r_thread.Get()
 	);
 
 	TzodView view(*fs, s_logger, app, appWindow.CmdClose());